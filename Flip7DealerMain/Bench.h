@@ -0,0 +1,214 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+//
+//  Cycle-count benchmarks for the hot routines, run on the ATmega328P itself or on simavr (tools/avr_bench.sh does
+//  the build and the simulator run). Host timings say little about a 16 MHz AVR with no FPU. Timer1 runs at the full
+//  CPU clock during the suite, so counts are exact CPU cycles, interrupts included. The call and the measurement
+//  itself are subtracted.
+//
+//  Stack use is measured the same way StackMonitor.h does it for the whole run: the space below the current stack
+//  pointer is painted, the routine runs, and whatever it overwrote is how deep it went (the call included).
+//
+//  Each routine prints one line over Serial at 115200 baud:
+//
+//      BENCH <name> n=<runs> min=<cycles> avg=<cycles> max=<cycles> stack=<bytes>
+//
+//  With enableBenchmarks on, setup() runs the suite once everything is initialised, then stops the CPU. The
+//  simulator exits there. Timer1 belongs to the Servo library the rest of the time, so the feed servo is detached.
+//  In simavr, no I2C device answers. colorRead() and updateScrollText() then give up at the address NACK, and
+//  their counts cover only the CPU's side of the bus transfers.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "StackMonitor.h"
+#include "games/Flip7.h"
+#include "games/Flip7Inspector.h"
+
+#if enableBenchmarks
+
+#ifndef __AVR__
+#error "Bench.h counts AVR cycles. Run it with tools/avr_bench.sh, or on a Nano."
+#endif
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#define BENCH_RUNS 16
+#define BENCH_STACK_WINDOW 320 // Bytes painted below the stack pointer, fewer if the heap is closer. Deeper reads as "stack=>" that.
+
+extern Servo feedCard;
+extern uint16_t scrollDelayTime;
+void colorRead(uint16_t blackBaseline);
+uint16_t calculateBlackBaseline();
+bool checkForColorSpike(uint16_t c, uint16_t blackBaseline);
+void checkButtons();
+void startScrollText(const char* text, uint16_t start, uint16_t delay, uint16_t end);
+void updateScrollText();
+
+Flip7 benchGame;
+
+// One press per Flip7 state, picked so that nothing moves the turntable or deals: the handler's own cost, not a seek.
+struct BenchPress {
+    uint8_t state;
+    uint8_t button;
+    char name[12];
+};
+
+const BenchPress benchPresses[] PROGMEM = {
+    { Flip7::STARTUP, Buttons::BLUE, "STARTUP" },
+    { Flip7::DEALSPECIAL, Buttons::RED, "DEALSPECIAL" },
+    { Flip7::ACTION, Buttons::YELLOW, "ACTION" },
+    { Flip7::PICK, Buttons::YELLOW, "PICK" },
+    { Flip7::PICKSPECIAL, Buttons::YELLOW, "PICKSPECIAL" },
+    { Flip7::PICKPLAYER, Buttons::BLUE, "PICKPLAYER" },
+    { Flip7::ENTERSCORE, Buttons::BLUE, "ENTERSCORE" },
+    { Flip7::REPORTSCORE, Buttons::YELLOW, "REPORTSCORE" },
+    { Flip7::SHOWSCORES, Buttons::BLUE, "SHOWSCORES" },
+    { Flip7::GAMEOVER, Buttons::YELLOW, "GAMEOVER" },
+};
+
+volatile uint16_t benchOverflows = 0;
+BenchPress benchPress; // The press the next run of benchButtonPress() makes.
+
+ISR(TIMER1_OVF_vect) {
+    benchOverflows++;
+}
+
+uint32_t benchCycles() {
+    uint8_t oldSREG = SREG;
+    cli();
+    uint16_t low = TCNT1;
+    uint16_t high = benchOverflows;
+    if ((TIFR1 & bit(TOV1)) && low < 0x8000) {
+        high++; // Overflowed after cli() but before the read.
+    }
+    SREG = oldSREG;
+    return ((uint32_t)high << 16) | low;
+}
+
+void benchStartTimer() {
+    feedCard.detach();
+    TCCR1A = 0;
+    TCCR1B = bit(CS10); // No prescaler: one count per CPU cycle.
+    TIMSK1 = bit(TOIE1);
+    benchOverflows = 0;
+    TCNT1 = 0;
+}
+
+// Each routine takes no arguments, so they all go through the same call.
+void benchNothing() {}
+void benchColorRead() { colorRead(calculateBlackBaseline()); }
+void benchColorSpike() { checkForColorSpike(900, 120); }
+void benchScrollText() { scrollDelayTime = 0; updateScrollText(); } // Due now, so every run shifts the text.
+void benchCheckButtons() { checkButtons(); }
+void benchCycleOnesDigit() { Flip7Inspector::cycleOnesDigit(benchGame, 0); }
+void benchButtonPress() {
+    Flip7Inspector::setState(benchGame, benchPress.state);
+    benchGame.handleButtonPress(benchPress.button);
+}
+
+struct BenchResult {
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t totalCycles;
+    uint16_t stack;
+    uint16_t window; // Bytes painted, so the most stack that could be seen.
+};
+
+uint32_t benchOverhead = 0; // Cycles benchMeasure() reports for benchNothing(), taken off every other result.
+
+void __attribute__((noinline)) benchMeasure(void (*routine)(), BenchResult& result) {
+    result = { 0xFFFFFFFF, 0, 0, 0, BENCH_STACK_WINDOW };
+    for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+        uint8_t* top = (uint8_t*)SP;
+        uint8_t* heapEnd = __brkval ? (uint8_t*)__brkval : &__heap_start; // Below here are the globals and heap being measured.
+        uint8_t* floor = top - heapEnd > BENCH_STACK_WINDOW ? top - BENCH_STACK_WINDOW : heapEnd;
+        uint16_t window = top - floor;
+        if (window < result.window) {
+            result.window = window;
+        }
+        for (uint8_t* p = floor; p < top - 16; p++) { // Leave room for this loop's own pushes.
+            *p = STACK_CANARY;
+        }
+
+        uint32_t start = benchCycles();
+        routine();
+        uint32_t cycles = benchCycles() - start;
+        cycles = cycles > benchOverhead ? cycles - benchOverhead : 0;
+
+        uint8_t* deepest = floor;
+        while (deepest < top && *deepest == STACK_CANARY) {
+            deepest++;
+        }
+        uint16_t used = top - deepest;
+        if (used > result.stack) {
+            result.stack = used;
+        }
+        if (cycles < result.minCycles) {
+            result.minCycles = cycles;
+        }
+        if (cycles > result.maxCycles) {
+            result.maxCycles = cycles;
+        }
+        result.totalCycles += cycles;
+    }
+}
+
+void benchReport(const __FlashStringHelper* prefix, const char* name, void (*routine)()) {
+    BenchResult result;
+    benchMeasure(routine, result);
+    Serial.print(F("BENCH "));
+    Serial.print(prefix);
+    Serial.print(name);
+    Serial.print(F(" n="));
+    Serial.print(BENCH_RUNS);
+    Serial.print(F(" min="));
+    Serial.print(result.minCycles);
+    Serial.print(F(" avg="));
+    Serial.print(result.totalCycles / BENCH_RUNS);
+    Serial.print(F(" max="));
+    Serial.print(result.maxCycles);
+    Serial.print(F(" stack="));
+    if (result.stack >= result.window) {
+        Serial.print('>');
+    }
+    Serial.println(result.stack);
+    Serial.flush(); // Sending is interrupt driven, so finish before the next measurement.
+}
+
+void runBenchmarks() {
+    Serial.begin(115200);
+    Serial.print(F("BENCH start free="));
+    Serial.println(freeSramNow());
+    benchStartTimer();
+
+    BenchResult calibration;
+    benchMeasure(benchNothing, calibration);
+    benchOverhead = calibration.minCycles;
+
+    benchReport(F(""), "colorRead", benchColorRead);
+    benchReport(F(""), "checkForColorSpike", benchColorSpike);
+    startScrollText("BENCH SCROLLING TEXT ", 0, 0, 0);
+    benchReport(F(""), "updateScrollText", benchScrollText);
+    benchReport(F(""), "checkButtons", benchCheckButtons);
+
+    Flip7Inspector::seatPlayers(benchGame, 4);
+    benchReport(F(""), "cycleOnesDigit", benchCycleOnesDigit);
+    for (uint8_t i = 0; i < sizeof(benchPresses) / sizeof(benchPresses[0]); i++) {
+        memcpy_P(&benchPress, &benchPresses[i], sizeof(benchPress));
+        benchReport(F("Flip7::handleButtonPress:"), benchPress.name, benchButtonPress);
+    }
+
+    Serial.println(F("BENCH done"));
+    Serial.flush();
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu(); // Asleep with interrupts off: simavr ends the run here, and a real Nano stays put until reset.
+}
+
+#endif // enableBenchmarks
+
+#endif // BENCH_H
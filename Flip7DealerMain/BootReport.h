@@ -0,0 +1,57 @@
+#ifndef BOOT_REPORT_H
+#define BOOT_REPORT_H
+
+//
+//  Times each phase of setup() so we can see where boot time goes. setup() calls markBootPhase() as each phase
+//  finishes. The results show on the "*6-DIAGNOSTICS" page and go out as telemetry events.
+//
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "Config.h"
+#include "Telemetry.h"
+
+enum BootPhase : uint8_t {
+    BOOT_SENSOR,    // Colour sensor start-up and configuration.
+    BOOT_PINS,      // Pin modes, feed servo and motor driver.
+    BOOT_DISPLAY,   // Display start-up.
+    BOOT_EEPROM,    // Loading tuned colours and the UV threshold.
+    BOOT_SELF_TEST, // startRoutine() motor wiggle, when it runs.
+    BOOT_IR_CHECK,  // Checking the craw is clear.
+    BOOT_HOLD,      // Holding " HI " on the display while the colour sensor warms up.
+    NUM_BOOT_PHASES
+};
+
+const char bootPhaseNames[NUM_BOOT_PHASES][5] PROGMEM = { "SENS", "PINS", "DISP", "EEPR", "MOTR", "IR", "HOLD" };
+
+uint16_t bootPhaseTimes[NUM_BOOT_PHASES]; // ms spent in each phase during the last boot.
+unsigned long bootPhaseStart = 0;
+
+void markBootPhase(uint8_t phase) {
+    unsigned long now = millis();
+    bootPhaseTimes[phase] = now - bootPhaseStart;
+    bootPhaseStart = now;
+    logEvent(EVT_BOOT_PHASE, phase, bootPhaseTimes[phase]);
+}
+
+// Diagnostics page: one line per phase, then the total, e.g. "EEPR 3MS ", "BOOT 1650MS ".
+uint8_t bootReportLineCount() {
+    return NUM_BOOT_PHASES + 1;
+}
+
+void formatBootReportLine(uint8_t line, char* buffer, size_t size) {
+    if (line == NUM_BOOT_PHASES) {
+        unsigned long total = 0;
+        for (uint8_t i = 0; i < NUM_BOOT_PHASES; i++) {
+            total += bootPhaseTimes[i];
+        }
+        snprintf(buffer, size, "BOOT %luMS ", total);
+        return;
+    }
+    char name[5];
+    strncpy_P(name, bootPhaseNames[line], sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    snprintf(buffer, size, "%s %uMS ", name, bootPhaseTimes[line]);
+}
+
+#endif // BOOT_REPORT_H
@@ -0,0 +1,82 @@
+#ifndef BUS_ARBITER_H
+#define BUS_ARBITER_H
+
+//
+//  I2C bus arbiter. The colour sensor and the display backpack share the Wire bus. While the turntable is moving,
+//  a late colour reading is how DEALR overshoots a tag. So sensor reads get the bus first, and display frames wait
+//  for a gap.
+//
+//  Drawing functions still change the display's buffer straight away. Only the I2C write (writeDisplayFrame()) is
+//  arbitrated:
+//    - Stopped, or nobody is reading the sensor (a timed spin, for example): the frame goes out immediately.
+//    - Moving, with the next colour sample nearly ready: the frame is held. colorRead() sends it right after the
+//      next reading, which is the longest gap before the sensor is ready again. Only the newest frame is kept.
+//  rotateStop() sends anything still held. The bus also runs in 400 kHz fast mode, which both devices support.
+//
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_LEDBackpack.h>
+#include "Config.h"
+
+extern Adafruit_AlphaNum4 display;
+extern bool stopped;
+
+const uint32_t i2cClock = 400000;          // Fast mode. The HT16K33 backpack and the colour sensor are both rated for it. Use 100000 with long sensor wires.
+const uint16_t sensorSampleMicros = 8000;  // A fresh colour sample every integration time (0x1 = 8 ms, set in setup()).
+const uint16_t displayWriteMicros = 700;   // A full display write at 400 kHz, with some margin.
+
+bool displayFramePending = false;          // A frame is waiting for a gap between sensor reads.
+unsigned long lastSensorReadAt = 0;        // micros() of the last colour reading.
+uint16_t displayFramesDeferred = 0;        // How many frames had to wait, for the diagnostics page.
+
+// Called once the display is started. Wire.begin() (run by display.begin()) resets the clock, so this comes after it.
+void setBusFastMode() {
+    Wire.setClock(i2cClock);
+}
+
+// True when a display write now could hold up the next colour sample.
+bool sensorReadDueSoon() {
+    if (stopped) {
+        return false;
+    }
+    unsigned long sinceRead = micros() - lastSensorReadAt;
+    return sinceRead + displayWriteMicros >= sensorSampleMicros && sinceRead < 2UL * sensorSampleMicros;
+}
+
+void writeDisplayFrame() {
+    if (sensorReadDueSoon()) {
+        if (!displayFramePending) {
+            displayFramesDeferred++;
+        }
+        displayFramePending = true;
+        return;
+    }
+    displayFramePending = false;
+    display.writeDisplay();
+}
+
+// Sends a held frame, if there is one. Called right after each colour reading and when the turntable stops.
+void flushDisplayFrame() {
+    if (displayFramePending) {
+        displayFramePending = false;
+        display.writeDisplay();
+    }
+}
+
+// colorRead() calls this as soon as a reading is in. The bus is now free for the longest stretch it will get.
+void onSensorRead() {
+    lastSensorReadAt = micros();
+    flushDisplayFrame();
+}
+
+// Diagnostics page: "I2C 400KHZ HELD 37 ".
+uint8_t busLineCount() {
+    return 1;
+}
+
+void formatBusLine(uint8_t line, char* buffer, size_t size) {
+    snprintf(buffer, size, "I2C %luKHZ HELD %u ", (unsigned long)(i2cClock / 1000), displayFramesDeferred);
+}
+
+#endif // BUS_ARBITER_H
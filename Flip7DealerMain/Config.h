@@ -12,5 +12,26 @@ uint16_t textStartHoldTime = 800;                      // Amount of time (in ms)
 uint16_t textEndHoldTime = 800;                        // Amount of time (in ms) that scrolling text should pause at the end of a scroll.
 const unsigned long timeUntilScreensaverStart = 55000; // When this amount of time expires (in milliseconds), the intro animation starts as a screensaver.
 const unsigned long expressionDuration = 500;          // DEALR makes faces when it deals cards. This value determines the amount of time it makes the face for.
+bool fastBoot = true;                                  // Skips the motor wiggle at boot unless the last session hit an error or a button is held at power-on, and shortens the " HI " hold. Set to false for the full boot.
+const unsigned long fastBootHoldTime = 400;            // How long (in ms) " HI " stays up with fast boot.
+bool lowPowerIdle = true;                              // Enables/disables low-power idling (dim display, servo and motor driver off, CPU sleep) during the screensaver and long waits at game prompts.
+const unsigned long timeUntilPromptIdle = 20000;       // How long (in ms) a game prompt can sit untouched before DEALR starts idling in low power.
+bool adaptivePacing = true;                            // Shortens scroll timings and display holds in games for tables that answer prompts quickly, down to 60% of the values above. See Pacing.h.
+bool watchdogReset = true;                             // Resets DEALR if it gets stuck for about 8 seconds. A Flip7 game in progress picks up again at its score screen. See Watchdog.h.
+
+// DIAGNOSTICS
+// Everything below is reported on the "*6-DIAGNOSTICS" tools page. Serial output has to be compiled in on purpose, since just
+// referencing Serial costs about 1.5 KB of flash and 180 bytes of RAM for its buffers.
+#define enableSerialReports false                      // Prints diagnostics over Serial at 115200 baud (scheduler overruns, and dumps from the diagnostics page with G).
+#define enableTelemetry false                          // Streams binary event frames (state changes, buttons, tags, cards, errors) over Serial at 115200 baud. Decode them with tools/telemetry_decode.py.
+#define enableConsole false                            // Accepts text commands over Serial (button presses, state queries, seeks, deals, counters) for scripted soak runs. See Console.h.
+#define enableFlightRecorder false                     // Keeps the last 16 events in RAM (about 100 bytes) and saves them to EEPROM when an error happens, for the diagnostics page and console.
+#define enableTracing false                            // Sends begin/end spans around seeks, fine adjusts, card throws and game button handling. Needs enableTelemetry. Convert a capture with tools/trace_to_chrome.py.
+#define enableRoundStats false                         // Times each round and game by what DEALR was doing (rotating, dealing, waiting, scoring) and adds the split to Flip7's score screen. Uses about 150 bytes of RAM.
+#define enableProfiler false                           // Times loop(), colorRead(), updateDisplay() and game button handling with micros(). Uses about 150 bytes of RAM.
+#define enableBenchmarks false                         // Counts CPU cycles and stack use of the hot routines at boot, prints them over Serial, then stops. Run it in simavr with tools/avr_bench.sh.
+#define enableSessionRecording false                   // Adds every colour sample, button edge and the EEPROM contents at boot to telemetry, so host/dealr_replay can play the session back. Needs enableTelemetry.
+#define enableDealerLink false                         // Lets two DEALRs share one big table over their TX/RX pins, each dealing to the tags it registered. Needs Serial to itself. See DealerLink.h.
+#define dealerLinkFollower false                       // With enableDealerLink, makes this DEALR the follower: it only registers, seeks and deals for the leader, which runs the game.
 
 #endif // GameConfig
\ No newline at end of file
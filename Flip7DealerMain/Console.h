@@ -0,0 +1,242 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+//
+//  A small text command console on Serial (115200 baud, one command per line), so a host script can drive
+//  DEALR through long unattended runs instead of someone pressing buttons for a whole game. Every command
+//  answers with exactly one line that starts with the command's letter, or "? <line>" if it wasn't understood.
+//
+//      b <g|b|y|r> [l]  Press a button (add "l" for a long press). Runs the same actions a real press does.
+//      q                States: "q deal=<dealState> disp=<displayState> game=<index or -1> state=<getStateId()>"
+//      p                Players and scores from the current game: "p <count> <color>:<score> ..."
+//      k [n]            Seek n tags clockwise (default 1): "k <color> <ms>". Only while DEALR is stopped.
+//      d [n]            Deal n cards where DEALR is pointing (default 1): "d <n> <ms>". Only while DEALR is stopped.
+//      f                The flight recorder's last saved fault, one "f ..." line per record, oldest first, ending with "f end".
+//      m                SRAM headroom in bytes: "m <free now> <lowest since boot>"
+//      c [r]            Event counters since boot: "c <ms> <EVENT>=<count> ...". "c r" zeroes them after replying.
+//
+//  Seeks and deals block until they finish, just like the tools menu, so the reply doubles as a completion
+//  signal and the ms field is the time the move took. tools/dealr_soak.py uses these to run deal and rotation
+//  cycles and report throughput and failure rates.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Enums.h"
+#include "Game.h"
+#include "Telemetry.h"
+#include "StackMonitor.h"
+#include "FlightRecorder.h"
+#include "Watchdog.h"
+
+#if enableConsole
+
+// Globals and functions from the main file.
+extern Game* currentGamePtr;
+extern int8_t currentGame;
+extern uint8_t previousActiveColor;
+void pressButton(int buttonPin, bool longPress, void (*action)());
+void onButton1Release();
+void onButton1LongPress();
+void onButton2Release();
+void onButton2LongPress();
+void onButton3Release();
+void onButton3LongPress();
+void onButton4Release();
+void onButton4LongPress();
+
+struct ConsoleButton {
+    char letter;
+    uint8_t pin;
+    void (*onRelease)();
+    void (*onLongPress)();
+};
+
+const ConsoleButton consoleButtons[] PROGMEM = {
+    { 'g', BUTTON_PIN_1, onButton1Release, onButton1LongPress },
+    { 'b', BUTTON_PIN_2, onButton2Release, onButton2LongPress },
+    { 'y', BUTTON_PIN_3, onButton3Release, onButton3LongPress },
+    { 'r', BUTTON_PIN_4, onButton4Release, onButton4LongPress },
+};
+
+char consoleLine[16]; // Longest command is "b g l", so this leaves plenty of room.
+uint8_t consoleLength = 0;
+
+// Reads the optional number after a command letter, e.g. the 3 in "k 3".
+uint8_t consoleCount(const char* args) {
+    uint8_t count = atoi(args);
+    return count > 0 ? count : 1;
+}
+
+// Seeks and deals drive the motors directly, so they are only allowed while no deal state owns them.
+bool consoleMotorsFree() {
+    return currentDealState == IDLE || currentDealState == AWAITING_PLAYER_DECISION;
+}
+
+void consoleButton(const char* args) {
+    while (*args == ' ') {
+        args++;
+    }
+    for (uint8_t i = 0; i < sizeof(consoleButtons) / sizeof(consoleButtons[0]); i++) {
+        ConsoleButton button;
+        memcpy_P(&button, &consoleButtons[i], sizeof(button));
+        if (button.letter == *args) {
+            bool longPress = strchr(args + 1, 'l') != nullptr;
+            pressButton(button.pin, longPress, longPress ? button.onLongPress : button.onRelease);
+            Serial.print(F("b "));
+            Serial.println(button.pin);
+            return;
+        }
+    }
+    Serial.println(F("? b"));
+}
+
+void consoleQuery() {
+    Serial.print(F("q deal="));
+    Serial.print(currentDealState);
+    Serial.print(F(" disp="));
+    Serial.print(currentDisplayState);
+    Serial.print(F(" game="));
+    Serial.print(currentGamePtr ? currentGame : -1);
+    Serial.print(F(" state="));
+    Serial.println(currentGamePtr ? currentGamePtr->getStateId() : 0);
+}
+
+void consolePlayers() {
+    uint8_t count = currentGamePtr ? currentGamePtr->getPlayerCount() : 0;
+    Serial.print(F("p "));
+    Serial.print(count);
+    for (uint8_t i = 0; i < count; i++) {
+        Serial.print(' ');
+        Serial.print(currentGamePtr->getPlayerColor(i));
+        Serial.print(':');
+        Serial.print(currentGamePtr->getPlayerScore(i));
+    }
+    Serial.println();
+}
+
+void consoleSeek(const char* args) {
+    if (!consoleMotorsFree()) {
+        Serial.println(F("? k busy"));
+        return;
+    }
+    unsigned long start = millis();
+    for (uint8_t n = consoleCount(args); n > 0 && !flags4.errorInProgress; n--) {
+        feedWatchdog(); // Each seek gets its own watchdog period.
+        TRACE_SPAN(SPAN_STEP, activeColor);
+        moveOffActiveColor(CW);
+        returnToActiveColor(CW);
+        previousActiveColor = activeColor;
+    }
+    Serial.print(F("k "));
+    Serial.print(activeColor);
+    Serial.print(' ');
+    Serial.println(millis() - start);
+}
+
+void consoleDeal(const char* args) {
+    if (!consoleMotorsFree()) {
+        Serial.println(F("? d busy"));
+        return;
+    }
+    unsigned long start = millis();
+    uint8_t dealt = 0;
+    for (uint8_t n = consoleCount(args); n > 0 && !flags4.errorInProgress; n--) {
+        feedWatchdog(); // Each card has its own timeout, so it gets its own watchdog period.
+        dealSingleCard(1);
+        flags1.cardDealt = false;
+        dealt++;
+    }
+    Serial.print(F("d "));
+    Serial.print(dealt);
+    Serial.print(' ');
+    Serial.println(millis() - start);
+}
+
+void consoleFlightRecord() {
+#if enableFlightRecorder
+    char line[30];
+    for (uint8_t i = 0; i < flightLineCount(); i++) {
+        formatFlightLine(i, line, sizeof(line));
+        Serial.print(F("f "));
+        Serial.println(line);
+    }
+#endif
+    Serial.println(F("f end"));
+}
+
+void consoleMemory() {
+    Serial.print(F("m "));
+    Serial.print(freeSramNow());
+    Serial.print(' ');
+    Serial.println(stackLowWater());
+}
+
+void consoleCounters(const char* args) {
+    Serial.print(F("c "));
+    Serial.print(millis());
+    for (uint8_t id = 1; id < NUM_TELEMETRY_EVENTS; id++) {
+        Serial.print(' ');
+        Serial.print((const __FlashStringHelper*)telemetryEvents[id].name);
+        Serial.print('=');
+        Serial.print(eventCounts[id]);
+    }
+    Serial.println();
+    if (strchr(args, 'r')) {
+        memset(eventCounts, 0, sizeof(eventCounts));
+    }
+}
+
+void runConsoleCommand() {
+    const char* args = consoleLine + 1;
+    switch (consoleLine[0]) {
+        case 'b':
+            consoleButton(args);
+            break;
+        case 'q':
+            consoleQuery();
+            break;
+        case 'p':
+            consolePlayers();
+            break;
+        case 'k':
+            consoleSeek(args);
+            break;
+        case 'd':
+            consoleDeal(args);
+            break;
+        case 'f':
+            consoleFlightRecord();
+            break;
+        case 'm':
+            consoleMemory();
+            break;
+        case 'c':
+            consoleCounters(args);
+            break;
+        default:
+            Serial.print(F("? "));
+            Serial.println(consoleLine);
+            break;
+    }
+}
+
+// Scheduler task: collects characters into a line and runs it once the line ends.
+void runConsoleTask() {
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+        if (c == '\n' || c == '\r') {
+            if (consoleLength > 0) {
+                consoleLine[consoleLength] = '\0';
+                consoleLength = 0;
+                runConsoleCommand();
+            }
+        } else if (consoleLength < sizeof(consoleLine) - 1) {
+            consoleLine[consoleLength++] = c;
+        }
+    }
+}
+
+#endif // enableConsole
+
+#endif // CONSOLE_H
@@ -0,0 +1,237 @@
+#ifndef DEALER_LINK_H
+#define DEALER_LINK_H
+
+//
+//  Two DEALRs splitting one big table. They're wired TX to RX both ways with the grounds joined, and talk text
+//  lines over Serial at 115200 baud. The leader runs the game: its buttons, its display and every score. The
+//  follower sits in its menu and only does what the leader asks for the seats it registered. A Flip7 game seats
+//  the leader's tags first, then the follower's, so put the two so their tags run on round the table in that order.
+//
+//  The leader sends one command per line, and the follower answers each with one line that starts with the
+//  command's letter, or "? <letter> ..." if it couldn't:
+//
+//      h                  Is anyone there: "h"
+//      r                  Register: one lap of the follower's tags, "r <count> <color> <color> ..."
+//      s <color>          Seek to that tag: "s <color> <ms>". The leader doesn't wait for this one.
+//      d <color> <n>      Seek to that tag if it isn't there yet, then deal n cards: "d <n> <ms>"
+//
+//  Seeks go out as soon as a follower seat's turn comes up, so the follower turns while the players decide, and
+//  only the deal waits. A hit at a follower seat then costs about what it does at the leader's own seats, however
+//  far round the table it is. tools/dealer_peer.py stands in for a follower, to try a leader out on a computer.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Definitions.h"
+#include "Enums.h"
+#include "ColorNames.h"
+#include "Watchdog.h"
+
+#if enableDealerLink
+
+#if enableConsole || enableTelemetry || enableSerialReports
+#error "The dealer link needs Serial to itself. Turn off enableConsole, enableTelemetry and enableSerialReports."
+#endif
+
+// Globals and functions from the main file.
+extern dealState currentDealState;
+extern uint8_t activeColor;
+extern uint8_t previousActiveColor;
+void reportError(errorCode code);
+void moveOffActiveColor(bool rotateClockwise);
+void returnToActiveColor(bool rotateClockwise);
+void colorScan();
+void dealSingleCard(uint8_t amount);
+
+const unsigned long linkHelloTimeout = 300;     // A follower answers h straight away, so a leader on its own isn't kept waiting.
+const unsigned long linkRegisterTimeout = 20000; // A lap of up to 8 tags.
+const unsigned long linkSeekTimeout = 10000;     // Most of a lap, for a deal whose seek hasn't finished yet.
+const unsigned long linkCardTimeout = 5000;      // Each card, a little over throwExpiration.
+
+char linkLine[24]; // The longest line is "r 8" and eight colors.
+uint8_t linkLength = 0;
+
+// Collects characters from the other DEALR. Returns true once a whole line is in linkLine.
+bool linkReadLine() {
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+        if (c == '\n' || c == '\r') {
+            if (linkLength > 0) {
+                linkLine[linkLength] = '\0';
+                linkLength = 0;
+                return true;
+            }
+        } else if (linkLength < sizeof(linkLine) - 1) {
+            linkLine[linkLength++] = c;
+        }
+    }
+    return false;
+}
+
+#if !dealerLinkFollower
+
+// Waits for the answer to the command with this letter, passing over answers to seeks nobody waited for.
+bool linkAwait(char letter, unsigned long timeout) {
+    unsigned long start = millis();
+    while (millis() - start < timeout) {
+        feedWatchdog(); // The timeout is the limit here.
+        if (linkReadLine()) {
+            if (linkLine[0] == letter) {
+                return true;
+            }
+            if (linkLine[0] == '?' && linkLine[2] == letter) {
+                break;
+            }
+        }
+    }
+    reportError(ERR_LINK);
+    return false;
+}
+
+bool linkHello() {
+    while (Serial.available() > 0) {
+        Serial.read(); // Anything left from before is stale.
+    }
+    linkLength = 0;
+    Serial.println('h');
+    unsigned long start = millis();
+    while (millis() - start < linkHelloTimeout) {
+        if (linkReadLine() && linkLine[0] == 'h') {
+            return true;
+        }
+    }
+    return false; // No follower. Not an error, the game just has the leader's seats.
+}
+
+// Has the follower register its seats. Fills up to `room` colors and returns how many it found.
+uint8_t linkRegister(uint8_t* colors, uint8_t room) {
+    Serial.println('r');
+    if (!linkAwait('r', linkRegisterTimeout)) {
+        return 0;
+    }
+    char* next = linkLine + 1;
+    uint8_t count = strtoul(next, &next, 10);
+    uint8_t found = 0;
+    while (found < count && found < room) {
+        colors[found++] = strtoul(next, &next, 10);
+    }
+    return found;
+}
+
+void linkSeek(uint8_t color) {
+    Serial.print(F("s "));
+    Serial.println(color);
+}
+
+bool linkDeal(uint8_t color, uint8_t amount) {
+    Serial.print(F("d "));
+    Serial.print(color);
+    Serial.print(' ');
+    Serial.println(amount);
+    return linkAwait('d', linkSeekTimeout + amount * linkCardTimeout);
+}
+
+#else // dealerLinkFollower
+
+// Steps clockwise to the tag. Gives up after a lap, if it's not on this table.
+bool linkStepTo(uint8_t color) {
+    for (uint8_t steps = 0; activeColor != color; steps++) {
+        if (steps > NUM_PLAYER_COLORS || flags4.errorInProgress) {
+            return false;
+        }
+        feedWatchdog(); // Each step gets its own watchdog period.
+        moveOffActiveColor(CW);
+        returnToActiveColor(CW);
+        previousActiveColor = activeColor;
+    }
+    return true;
+}
+
+void linkRegisterSeats() {
+    uint8_t colors[NUM_PLAYER_COLORS];
+    uint8_t count = 0;
+    if (activeColor == 0) {
+        returnToActiveColor(CW);    // onto the first tag
+    }
+    uint8_t startingColor = activeColor;
+    do {
+        if (count == NUM_PLAYER_COLORS || flags4.errorInProgress) {
+            Serial.println(F("? r"));  // the start tag never came round again
+            return;
+        }
+        colors[count++] = activeColor;
+        feedWatchdog();
+        moveOffActiveColor(CW);
+        returnToActiveColor(CW);
+        previousActiveColor = activeColor;
+    } while (activeColor != startingColor);
+    Serial.print(F("r "));
+    Serial.print(count);
+    for (uint8_t i = 0; i < count; i++) {
+        Serial.print(' ');
+        Serial.print(colors[i]);
+    }
+    Serial.println();
+}
+
+void linkSeekAndDeal(bool deal) {
+    char* next = linkLine + 1;
+    uint8_t color = strtoul(next, &next, 10);
+    uint8_t amount = deal ? strtoul(next, &next, 10) : 0;
+    unsigned long start = millis();
+    if (!linkStepTo(color)) {
+        Serial.print(deal ? F("? d ") : F("? s "));
+        Serial.println(color);
+        return;
+    }
+    uint8_t dealt = 0;
+    for (; dealt < amount && !flags4.errorInProgress; dealt++) {
+        feedWatchdog(); // Each card has its own timeout, so it gets its own watchdog period.
+        dealSingleCard(1);
+        flags1.cardDealt = false;
+    }
+    Serial.print(deal ? 'd' : 's');
+    Serial.print(' ');
+    Serial.print(deal ? dealt : color);
+    Serial.print(' ');
+    Serial.println(millis() - start);
+}
+
+// Scheduler task on the follower: runs the leader's commands as their lines come in.
+void runDealerLinkTask() {
+    if (!linkReadLine()) {
+        return;
+    }
+    if (currentDealState != IDLE && currentDealState != AWAITING_PLAYER_DECISION) {
+        Serial.print(F("? "));
+        Serial.println(linkLine);   // the motors are busy with something from this DEALR's own menu
+        return;
+    }
+    for (uint8_t i = 0; i < 15; i++) {
+        colorScan();                // nothing's read the sensor since the last command, so get a stable color first
+    }
+    switch (linkLine[0]) {
+        case 'h':
+            Serial.println('h');
+            break;
+        case 'r':
+            linkRegisterSeats();
+            break;
+        case 's':
+            linkSeekAndDeal(false);
+            break;
+        case 'd':
+            linkSeekAndDeal(true);
+            break;
+        default:
+            Serial.print(F("? "));
+            Serial.println(linkLine);
+            break;
+    }
+}
+
+#endif // dealerLinkFollower
+
+#endif // enableDealerLink
+
+#endif // DEALER_LINK_H
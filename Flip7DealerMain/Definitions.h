@@ -24,6 +24,24 @@
 // OTHER PINS
 #define STNDBY 8 // Standby needs to be pulled HIGH. This can be done with a wire to 5V as well.
 
+// EEPROM LAYOUT
+// The version byte, tuned colours and UV threshold are at the start of EEPROM (see the main file). Everything else goes from
+// EEPROM_EXTRAS_START up, and the main file checks the two don't overlap.
+#define EEPROM_EXTRAS_START 80
+#define BOOT_FAULT_ADDR EEPROM_EXTRAS_START // Set when an error happened, so the next boot runs the motor self-check.
+#define BOOT_FAULT_SET 0xA5
+#define FLIGHT_RECORDER_ADDR (EEPROM_EXTRAS_START + 4) // The last flight recorder flush (see FlightRecorder.h).
+#define FLIGHT_RECORDER_END (EEPROM_EXTRAS_START + 120)
+#define GAME_SNAPSHOT_ADDR FLIGHT_RECORDER_END // The running game's snapshot, saved at round boundaries so it survives a reset.
+#define GAME_SNAPSHOT_MAGIC 0x5A
+#define GAME_SNAPSHOT_HEADER 3                 // Magic, game index and size. A CRC byte follows the data.
+#define GAME_SNAPSHOT_MAX_DATA 48
+#define SEAT_RING_ADDR (GAME_SNAPSHOT_ADDR + GAME_SNAPSHOT_HEADER + GAME_SNAPSHOT_MAX_DATA + 1) // The tags the last full registration found, so the next game can check a few instead of doing a lap.
+#define SEAT_RING_MAGIC 0x3C
+#define SEAT_RING_HEADER 2                     // Magic and seat count. A CRC byte follows the colors.
+#define SEAT_RING_MAX_SEATS 8
+#define SEAT_RING_END (SEAT_RING_ADDR + SEAT_RING_HEADER + SEAT_RING_MAX_SEATS + 1)
+
 #define CW true                            // Clockwise
 #define CCW false                          // Counter-Clockwise
 
@@ -35,4 +53,11 @@ struct RGBColor {
     uint16_t avgC;
 };
 
+// A page in the "*6-DIAGNOSTICS" tool. Each line is formatted on demand and scrolled on the display.
+struct DiagnosticsPage {
+    uint8_t (*lineCount)();
+    void (*formatLine)(uint8_t line, char* buffer, size_t size);
+    void (*dump)(); // Optional fuller Serial dump. When null, the page's lines are printed instead.
+};
+
 #endif // DEFINITIONS_H
\ No newline at end of file
@@ -34,6 +34,19 @@ enum displayState {
     CUSTOM_FACE             // Custom displays the `customFace` string, used by the Game class 
 };
 
+// ERROR CODE: Why DEALR gave up on what it was doing. Reported with telemetry errors.
+enum errorCode : uint8_t {
+    ERR_CARD_IN_CRAW_AT_BOOT, // The card-sensing IR circuit was blocked on boot.
+    ERR_NEED_TAGS,            // Saw red twice in a row while dealing, so there are no player tags.
+    ERR_INIT_TIMEOUT,         // Couldn't find the red tag within errorTimeout.
+    ERR_ADJUST_TIMEOUT,       // A fine adjustment couldn't settle on a colour within errorTimeout.
+    ERR_THROW_TIMEOUT,        // A card didn't finish dealing within throwExpiration and was retracted.
+    ERR_BAD_GAME,             // The selected game couldn't be loaded from the registry.
+    ERR_WATCHDOG,             // The last reset came from the watchdog, because loop() stopped coming round. Logged at boot.
+    ERR_LINK,                 // The other DEALR didn't answer a dealer link command in time, or couldn't do it (DealerLink.h).
+    ERR_SEAT_GONE,            // A game went two laps without finding a player's tag, so the player has left the table.
+};
+
 // Buttons
 enum Buttons : int {
     GREEN = BUTTON_PIN_1,
@@ -0,0 +1,108 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+//
+//  Flight recorder. The last FLIGHT_RECORDS events from logEvent() (state changes, tags, craw edges, buttons,
+//  cards, errors) are kept in a small ring in SRAM. When something goes wrong, reportError() or the watchdog
+//  copies the ring to a reserved EEPROM area. That way the lead-up to the last failure survives a reset or a power
+//  cycle, and can be read later on the "*6-DIAGNOSTICS" page or with the console's "f" command.
+//
+//  Each record is 6 bytes: event id, first field (low byte), second field, and time in 16 ms ticks.
+//
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "Config.h"
+#include "Definitions.h"
+#include "Telemetry.h"
+
+#if enableFlightRecorder
+
+#define FLIGHT_RECORDS 16
+#define FLIGHT_MAGIC 0x7E
+#define FLIGHT_REASON_WATCHDOG 0xFE // Flush reason when the watchdog fired. Otherwise the reason is an errorCode.
+
+struct FlightRecord {
+    uint8_t id;
+    uint8_t a;
+    uint16_t b;
+    uint16_t ticks; // millis() / 16. Wraps after about 17 minutes, which is plenty for working out the order of recent events.
+};
+
+struct FlightHeader {
+    uint8_t magic;
+    uint8_t reason;
+    uint8_t count;
+    uint16_t ticks; // When the flush happened, so record times can be shown relative to it.
+};
+
+static_assert(FLIGHT_RECORDER_ADDR + sizeof(FlightHeader) + FLIGHT_RECORDS * sizeof(FlightRecord) <= FLIGHT_RECORDER_END,
+    "The flight recorder doesn't fit in its EEPROM area.");
+
+FlightRecord flightRecords[FLIGHT_RECORDS];
+uint8_t flightNext = 0;  // Where the next record goes.
+uint8_t flightCount = 0; // How many records are in the ring, up to FLIGHT_RECORDS.
+
+void recordFlightEvent(uint8_t id, uint16_t a, uint16_t b) {
+    if (id == EVT_BOOT_PHASE || id == EVT_STACK || id == EVT_SPAN_BEGIN || id == EVT_SPAN_END) {
+        return; // Reports about DEALR itself, not about what it was doing.
+    }
+    FlightRecord& record = flightRecords[flightNext];
+    record.id = id;
+    record.a = a;
+    record.b = b;
+    record.ticks = millis() >> 4;
+    flightNext = (flightNext + 1) % FLIGHT_RECORDS;
+    if (flightCount < FLIGHT_RECORDS) {
+        flightCount++;
+    }
+}
+
+// Copies the ring to EEPROM, oldest record first. Only changed bytes are written, but it can still take a few hundred
+// ms, so this is only for error paths. Safe to call from the watchdog interrupt.
+void flushFlightRecorder(uint8_t reason) {
+    FlightHeader header = { FLIGHT_MAGIC, reason, flightCount, (uint16_t)(millis() >> 4) };
+    EEPROM.put(FLIGHT_RECORDER_ADDR, header);
+    uint8_t index = (flightNext + FLIGHT_RECORDS - flightCount) % FLIGHT_RECORDS;
+    for (uint8_t i = 0; i < flightCount; i++) {
+        EEPROM.put(FLIGHT_RECORDER_ADDR + sizeof(FlightHeader) + i * sizeof(FlightRecord), flightRecords[index]);
+        index = (index + 1) % FLIGHT_RECORDS;
+    }
+}
+
+bool readFlightHeader(FlightHeader& header) {
+    EEPROM.get(FLIGHT_RECORDER_ADDR, header);
+    return header.magic == FLIGHT_MAGIC && header.count <= FLIGHT_RECORDS;
+}
+
+// Diagnostics page: a header line, then one line per saved record, oldest first, e.g. "-1.2S TAG 3 1 ".
+uint8_t flightLineCount() {
+    FlightHeader header;
+    return readFlightHeader(header) ? header.count + 1 : 1;
+}
+
+void formatFlightLine(uint8_t line, char* buffer, size_t size) {
+    FlightHeader header;
+    if (!readFlightHeader(header)) {
+        snprintf(buffer, size, "NO FLIGHT RECORD ");
+        return;
+    }
+    if (line == 0) {
+        if (header.reason == FLIGHT_REASON_WATCHDOG) {
+            snprintf(buffer, size, "LAST FAULT WDOG ");
+        } else {
+            snprintf(buffer, size, "LAST FAULT ERR %u ", header.reason);
+        }
+        return;
+    }
+    FlightRecord record;
+    EEPROM.get(FLIGHT_RECORDER_ADDR + sizeof(FlightHeader) + (line - 1) * sizeof(FlightRecord), record);
+    uint16_t age = (uint16_t)(header.ticks - record.ticks) * 16UL / 100; // Tenths of a second before the flush.
+    char name[11];
+    strncpy_P(name, telemetryEvents[record.id < NUM_TELEMETRY_EVENTS ? record.id : 0].name, sizeof(name));
+    snprintf(buffer, size, "-%u.%uS %s %u %u ", age / 10, age % 10, name, record.a, record.b);
+}
+
+#endif // enableFlightRecorder
+
+#endif // FLIGHT_RECORDER_H
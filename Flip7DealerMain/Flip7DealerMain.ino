@@ -33,6 +33,19 @@ NHY3274TH is a custom color sensor that uses a custom library.
 #include "Definitions.h"
 #include "Faces.h"
 #include "ColorNames.h"
+#include "Scheduler.h"
+#include "Telemetry.h"
+#include "FlightRecorder.h"
+#include "SessionRecorder.h"
+#include "Console.h"
+#include "DealerLink.h"
+#include "PowerManager.h"
+#include "BootReport.h"
+#include "StackMonitor.h"
+#include "Watchdog.h"
+#include "BusArbiter.h"
+#include "RoundStats.h"
+#include "Bench.h"
 
 #pragma endregion LIBRARIES
 
@@ -77,16 +90,42 @@ Fixed values such as motor speeds, timeouts, and default thresholds.
 #define EEPROM_VERSION_ADDR 0
 #define EEPROM_VERSION 1
 #define UV_THRESHOLD_ADDR (TOTAL_COLORS * sizeof(RGBColor) + 2)
+static_assert(EEPROM_EXTRAS_START >= UV_THRESHOLD_ADDR + sizeof(uint16_t), "The EEPROM areas in Definitions.h overlap the colour table. Move EEPROM_EXTRAS_START up.");
+static_assert(NUM_PLAYER_COLORS <= SEAT_RING_MAX_SEATS, "The saved seat ring can't hold every player color. Raise SEAT_RING_MAX_SEATS in Definitions.h.");
 
 // TOOL MENUS INCLUDED
-const uint8_t numToolMenus = 4;        // Number of *index positions* for pre-programmed tuning routines (so "number of tool menus" - 1). If you add or subtract one, change this number.
+const uint8_t numToolMenus = 5;        // Number of *index positions* for pre-programmed tuning routines (so "number of tool menus" - 1). If you add or subtract one, change this number.
 const char toolsMenu[][26] PROGMEM = { // "26" defines the max number of characters you can use in these menu titles.
     "*1-DEAL ONE CARD",             // Deals a single card (useful for debugging card dealing)
     "*2-COLOR TUNER",                  // Place tags under sensor to "reset" color values for each tag
     "*3-UV TUNER",              // Deals 5 cards, and takes the highest reflectance value, adds a buffer, and calls that the "marked card threshold"
     "*4-RESET DEFAULT COLORS",           // Resets color and UV values to factory defaults
-    "*5-COLOR SENSOR"
-}; 
+    "*5-COLOR SENSOR",
+    "*6-DIAGNOSTICS"                // Scrolls scheduler and other runtime reports. Y/B pages through lines, R exits.
+};
+
+// DIAGNOSTICS PAGES
+// Each entry adds a page to the "*6-DIAGNOSTICS" tool.
+#if enableSerialReports
+#define DUMP_PROFILER dumpProfiler
+#else
+#define DUMP_PROFILER nullptr
+#endif
+const DiagnosticsPage diagnosticsPages[] PROGMEM = {
+    { schedulerLineCount, formatSchedulerLine, nullptr }, // Worst run time, lateness and budget overruns per scheduler task.
+    { bootReportLineCount, formatBootReportLine, nullptr }, // Time spent in each phase of the last boot.
+    { stackLineCount, formatStackLine, nullptr },           // Free SRAM now and the lowest it has been since boot.
+    { busLineCount, formatBusLine, nullptr },               // I2C clock and how many display frames waited for the colour sensor.
+#if enableRoundStats
+    { roundStatsLineCount, formatRoundStatsLine, nullptr }, // Where the current game's time went, per bucket, dealState and game state.
+#endif
+#if enableFlightRecorder
+    { flightLineCount, formatFlightLine, nullptr }, // The events leading up to the last saved fault.
+#endif
+#if enableProfiler
+    { profilerLineCount, formatProfilerLine, DUMP_PROFILER }, // Min/avg/max and 90th percentile per profiled section. The Serial dump adds the histograms.
+#endif
+};
 
 // STARTING STATES AND STATE UPDATE TAGS:
 dealState currentDealState = IDLE;                         // Current state of the dealing interaction, starting with IDLE on boot.
@@ -150,10 +189,13 @@ unsigned long adjustStart = 0;              // Tag for when a fine adjustment pr
 
 // TEXT AND ANIMATION TIMINGS
 uint16_t scrollDelayTime = 0;     // Variable for switching between scrolling and waiting intervals.
+uint16_t scrollStartHold = 0;     // Timings for the text scrolling now, as passed to startScrollText(). The Config.h values stay as they are.
+uint16_t scrollInterval = 0;
+uint16_t scrollEndHold = 0;
 unsigned long lastScrollTime = 0; // Tag for when we last shifted text over in scrolling animations.
 int scrollIndex = -1;             // Start at -1 to hold the first frame longer.
 uint8_t messageRepetitions = 0;   // Variable for storing the number of times we have repeated scrolling text.
-char message[30];                 // We use "char" to save RAM. This is the max scroll text length, but it can be increased if necessary.
+char message[36];                 // We use "char" to save RAM. This is the max scroll text length, but it can be increased if necessary. Fits the round times line from RoundStats.h.
 int8_t messageLine = 0;           // For messages that scroll several lines, this variable holds which line we're scrolling.
 const char* customFace = "0  0";
 
@@ -175,6 +217,7 @@ uint8_t stableColor = 0;                    // The stable color detected, which
 float totalColorValue = 0;                  // Variable for holding the value of all detected colors (R, G, and B) added together.
 const int8_t numSamples = 10;               // Number of samples for averaging color value.
 const uint8_t debounceCount = 3;            // Number of consecutive readings to confirm a color. More readings increases precision, but covers more radial distance. Too many readings can exceed tag width.
+const float spikeThreshold = 1.6;           // How many times the black baseline the clear channel must reach to count as a tag going by.
 uint8_t colorBuffer[debounceCount] = { 0 }; // Buffer to store the last few colors.
 
 // COLOR-MANAGING ARRAYS AND VARIABLES
@@ -202,6 +245,9 @@ to check, but using bools is an easy way to both set and check different dealing
 
 GameRegistry gameRegistry;
 Game* currentGamePtr = nullptr;
+#if enableEventLog
+uint8_t previousGameStateId = 0; // Last getStateId() reported for the current game, so game state changes can be logged.
+#endif
 Flags1 flags1;
 Flags2 flags2;
 Flags3 flags3;
@@ -228,7 +274,12 @@ can serve as a kind of table of contents for what to expect later.
 void startRoutine(); // Routine that runs in "setup". Includes motor test and initial blink animation.
 
 // State Machine Functions
-void checkState();                         // Function for constantly checking the current dealing state of DEALR.
+void checkState();                         // Function for tracking deal state changes. Every task that handles a deal state runs this first.
+void runLogicTask();                       // Scheduler task for the IDLE and RESET_DEALR states.
+void runMotionTask();                      // Scheduler task for the INITIALIZING and ADVANCING states.
+void runDispensingTask();                  // Scheduler task for the DEALING state.
+void runDisplayTask();                     // Scheduler task for prompt text while awaiting a player decision, and the screensaver timeout.
+void runSensingTask();                     // Scheduler task that polls the craw while a card is being thrown.
 void handleIdleState();                    // Handles what happens in the "IDLE" dealing state.
 void handleAdvancingState();               // Handles how to proceed when advancing from one player to another.
 void handleInitializingStateInAdjust();    // Handles when a fine-adjustment is called during initialization to the red tag.
@@ -276,6 +327,7 @@ void onButton3LongPress();              // Function for isolating when button th
 void onButton4Release();                // Function for isolating when button four is released.
 void onButton4LongPress();              // Function for isolating when button four is long-pressed.
 void resetTagsOnButtonPress();          // Convenience function that resets some state machine tags on each button press.
+void pressButton(int buttonPin, bool longPress, void (*action)()); // Runs a button's release or long-press action the way a real press does.
 void pollCraw();                        // Checks the IR sensor to see whether or not a card is in the mouth ("craw") of DEALR. Useful for determining whether or not cards have been successfully dealt.
 void colorRead(uint16_t blackBaseline); // Function for using the color-reading sensor to detect color underneath it.
 uint16_t calculateBlackBaseline();      // Retrieves the RGB value of "black" from EEPROM. We can compare readings against this to quickly detect spikes in brightness indicating tags.
@@ -319,10 +371,13 @@ void recordColors(int startIndex); // Helper function for colorTuner().
 void uvSensorTuner();              // Controls the "UV tuning" operation that locks down the threshold visible light value for a card to be determined "marked".
 void recordUVThreshold();          // Helper function for uvSensorTuner().
 void resetEEPROMToDefaults();      // Function for resetting EEPROM values to defaults.
+void diagnosticsViewer();          // Controls the "diagnostics" tool that scrolls runtime reports.
 
 // Error-and-Timeout-handling Functions
 void handleThrowingTimeout(unsigned long currentTime); // Handles timeouts while dealing cards.
+void resetThrowCardState();                            // Puts the feed servo and throw flags back after a card is dealt or given up on.
 void handleFineAdjustTimeout();                        // Handles timeout for fine adjustment moves.
+void reportError(errorCode code);                      // Logs an error and flags it in EEPROM so the next boot runs the motor self-check.
 void resetFlags();                                     // Resets all state machine flags when called.
 void resetColorsSeen();                                // Function used in the "reset" tool to reset colors seen.
 
@@ -333,6 +388,14 @@ void loadColorsFromEEPROM();                             // Whatever colors have
 void loadStoredUVValueFromEEPROM(uint16_t& uvThreshold); // Loads stored UV threshold values from EEPROM on boot.
 RGBColor readColorFromEEPROM(int index);                 // Helper function used in loadColorsFromEEPROM.
 RGBColor getBlackColorFromEEPROM();                      // Lets us check the value of our "baseline" luminance when no tag visible.
+void saveGameSnapshot(const void* data, uint8_t size);   // Saves the running game's snapshot (see Game::resume()) so it survives a reset.
+bool loadGameSnapshot(void* data, uint8_t size);         // Reads the snapshot back. False if there isn't a valid one of that size for the current game.
+void clearGameSnapshot();                                // Forgets the saved game, so the next boot starts at the menu.
+bool resumeSavedGame();                                  // At boot, picks up the game that saved a snapshot, if there is one.
+void startAtGamePrompt();                                // Puts DEALR at the current game's prompt, as if the deal had just finished.
+void saveSeatRing(const uint8_t* colors, uint8_t count); // Saves the tags a game registered, in clockwise order.
+uint8_t loadSeatRing(uint8_t* colors, uint8_t room);     // Reads them back. Returns how many, or 0 if there isn't a valid ring that fits.
+void clearSeatRing();                                    // Forgets the ring, so the next game registers with a full lap.
 
 
 #pragma endregion FUNCTION PROTOTYPES
@@ -346,6 +409,16 @@ In the setup for this build, we make sure our sensors are working and run a few
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void setup() {
+#if enableSerialReports || enableTelemetry || enableConsole || enableDealerLink
+    Serial.begin(115200);
+#endif
+#if enableTelemetry
+    sendTelemetrySchema();
+#endif
+    logEvent(EVT_BOOT);
+    if (watchdogCausedReset()) {
+        logEvent(EVT_ERROR, ERR_WATCHDOG, IDLE); // Not reportError(): the interrupt already saved the flight recorder and flagged the fault.
+    }
    // if (useSerial) {
        //Serial.begin(115200);
        // Serial.println(F("Beginning HP_DEALR_2_2_4 02/2025"));
@@ -364,8 +437,9 @@ void setup() {
         //if (verbose) {
       //      Serial.println(F("No NHY3274TH sensor found ... check your connections"));
        // }
+        delay(300);     // The sensor can still be powering up on a cold start. Give it a moment and try once more.
+        sensor.begin();
     }
-    delay(300);
 
     // COLOR SENSOR ATTACHMENT
     /*
@@ -388,9 +462,9 @@ void setup() {
   we stop the rotation motors, then *reverse* for a moment to check the color at a slower speed. This helps us bridge the gap between accuracy and speed.
   */
 
-    sensor.begin();                 // Start color sensor
-    sensor.setIntegrationTime(0x1); // Sets the integration time of the NHY3274TH sensor. 0x0 = 2ms; 0x1 = 8ms; 0x2 = 33ms; 0x3 = 132ms
+    sensor.setIntegrationTime(0x1); // Sets the integration time of the NHY3274TH sensor. 0x0 = 2ms; 0x1 = 8ms; 0x2 = 33ms; 0x3 = 132ms. BusArbiter.h times display writes around 8 ms samples.
     sensor.setGain(0x20);           // Sets gain of color sensor
+    markBootPhase(BOOT_SENSOR);
 
     // PIN ASSIGNMENTS
     pinMode(MOTOR_1_PIN_1, OUTPUT);      // Assign "Motor_1_pin_1" as an output
@@ -404,6 +478,7 @@ void setup() {
     pinMode(BUTTON_PIN_2, INPUT_PULLUP); // Set "Button_Pin_2" as a pull-up input
     pinMode(BUTTON_PIN_3, INPUT_PULLUP); // Set "Button_Pin_3" as a pull-up input
     pinMode(BUTTON_PIN_4, INPUT_PULLUP); // Set "Button_Pin_4" as a pull-up input
+    enableButtonWake();                  // Let button presses wake DEALR from low-power idle right away
     pinMode(CARD_SENS, INPUT);           // Set the card_sens pin as an input
     pinMode(UV_READER, INPUT);           // Set the UV_reader pin as an input
     pinMode(RIG_SWITCH, INPUT);          // Set the rig_switch as an input
@@ -413,7 +488,9 @@ void setup() {
 
     feedCard.attach(FEED_SERVO_PIN); // Attach the FEED_SERVO_PIN servo as a servo object
     digitalWrite(STNDBY, HIGH);      // The standby pin for the motor driver must be HIGH or the board will sleep
-    delay(50);
+    if (!fastBoot) {
+        delay(50);
+    }
 
     for (uint8_t i = 0; i < NUM_PLAYER_COLORS; i++) // This for-loop resets each of the "colors seen" to -1, setting us up for card-counting next deal
     {
@@ -422,12 +499,19 @@ void setup() {
 
     unsigned long seed = 0; // We do some pseudorandom number generation (PRNG) when chaotically dealing, and this "seed" determines the pseudorandom number starting point.
 
-    seed += analogRead(A7); // Normally we would read an unused analog pin, grabbing its randomly fluctuating voltage in order to augment the randomness of our seed value.
+    uint16_t uvNoise = analogRead(A7);
+    recordInput(A7, uvNoise);
+    seed += uvNoise;        // Normally we would read an unused analog pin, grabbing its randomly fluctuating voltage in order to augment the randomness of our seed value.
                             // In this case, all our analog pins are in use, so we pick the one that fluctuates the most: the UV sensor pin.
     randomSeed(seed);
+    markBootPhase(BOOT_PINS);
 
     display.begin(0x70);      // Initialize the display with its I2C address.
-    display.setBrightness(5); // Brightness can be set between 0 and 7.
+    setBusFastMode();         // 400 kHz I2C for the display and the colour sensor. See BusArbiter.h.
+    display.setBrightness(activeBrightness); // Brightness can be set between 0 and 7.
+    displayFace(" HI ");      // Say hi straight away. The rest of the boot happens while this is showing.
+    unsigned long hiShownAt = millis();
+    markBootPhase(BOOT_DISPLAY);
 
     resetColorsSeen();
 
@@ -438,6 +522,8 @@ void setup() {
     calculateBlackBaseline(); // Read the color values for black from EEPROM and sum them to create a baseline for the color black.
 
     loadStoredUVValueFromEEPROM(storedUVThreshold); // If we have never run the UV Tuning tool, the storedUVThreshold will be the default value.
+    recordEepromImage();
+    markBootPhase(BOOT_EEPROM);
 
     //if (verbose) {
         //Serial.println(F("Colors loaded from EEPROM are "));
@@ -448,12 +534,24 @@ void setup() {
        //printDealtCardsInfo();
     //}
 
-    if (motorStartRoutine) {
+    // With fast boot, the motor self-check only runs when the last session ended in an error, when a button is held down at power-on,
+    // or when there's a card stuck in the craw (the self-check retracts it).
+    bool buttonHeld = digitalRead(BUTTON_PIN_1) == LOW || digitalRead(BUTTON_PIN_2) == LOW || digitalRead(BUTTON_PIN_3) == LOW || digitalRead(BUTTON_PIN_4) == LOW;
+    bool faultRecorded = EEPROM.read(BOOT_FAULT_ADDR) == BOOT_FAULT_SET;
+    if (motorStartRoutine && (!fastBoot || faultRecorded || buttonHeld || digitalRead(CARD_SENS) == LOW)) {
         startRoutine(); // The start routine moves each of the motors a little to ensure they're working.
+        EEPROM.update(BOOT_FAULT_ADDR, 0);
+        while (digitalRead(BUTTON_PIN_1) == LOW || digitalRead(BUTTON_PIN_2) == LOW || digitalRead(BUTTON_PIN_3) == LOW || digitalRead(BUTTON_PIN_4) == LOW) {
+            // Wait for the held button to be let go, so it isn't taken as a menu press.
+        }
     }
+    markBootPhase(BOOT_SELF_TEST);
 
     while (digitalRead(CARD_SENS) == LOW) // This while-loop activates if the card-sensing IR circuit is triggered on boot.
     {
+        if (!flags4.errorInProgress) {
+            reportError(ERR_CARD_IN_CRAW_AT_BOOT);
+        }
         flags4.errorInProgress = true;
         while (!flags2.scrollingComplete && digitalRead(CARD_SENS) == LOW) {
             displayErrorMessage("EROR TUNE IR"); // If this error activates, there is either a card in the DEALR's mouth, or we need to tune the IR sensor screw.
@@ -461,10 +559,22 @@ void setup() {
         flags2.scrollingComplete = false;
         messageRepetitions = 0;
     }
+    if (!fastBoot || flags4.errorInProgress) { // The full boot holds " HI " for a whole second once everything else is done.
+        displayFace(" HI ");
+        hiShownAt = millis();
+    }
     flags4.errorInProgress = false;
+    markBootPhase(BOOT_IR_CHECK);
 
-    displayFace(" HI ");
-    delay(1000);
+    // Hold " HI " for a moment. With fast boot, the colour sensor's first (unsettled) readings are taken during the hold.
+    if (fastBoot) {
+        while (millis() - hiShownAt < fastBootHoldTime) {
+            colorScan();
+        }
+    } else {
+        delay(1000);
+    }
+    markBootPhase(BOOT_HOLD);
 
     currentDealState = IDLE;
     currentDisplayState = INTRO_ANIM;
@@ -473,6 +583,18 @@ void setup() {
     memset(&flags3, 0, sizeof(flags3));
     memset(&flags4, 0, sizeof(flags4));
     memset(&flags5, 0, sizeof(flags5));
+
+#if enableBenchmarks
+    runBenchmarks(); // Doesn't return. Runs before the watchdog is on, since some routines take a while to measure.
+#endif
+
+    if (buttonHeld) {
+        clearGameSnapshot(); // Holding a button at power-on starts fresh.
+        clearSeatRing();
+    } else {
+        resumeSavedGame();
+    }
+    enableWatchdog();
 }
 
 #pragma endregion SETUP
@@ -481,9 +603,12 @@ void setup() {
 
 // MAIN LOOP
 void loop() {
-    checkState();    // This function checks what state the DEALR is in (idle, dealing, awaiting player input, etc.) and lets the dealr behave accordingly.
-    checkButtons();  // This function checks to see if buttons are being pressed
-    checkTimeouts(); // This function tracks a few overall time-out circumstances (like, when the DEALR should go to sleep because it's bored!)
+    {
+        PROFILE_SCOPE(PROF_LOOP);
+        runScheduler(); // One pass over the scheduler's tasks (state handling, display, buttons, sensing). See Scheduler.h.
+    }
+    feedWatchdogFromLoop(); // See Watchdog.h.
+    sleepUntilNextTick(); // Only sleeps while idling in low power. See PowerManager.h.
 }
 
 #pragma endregion LOOP
@@ -493,24 +618,38 @@ void loop() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /*
 GAMEPLAY FLOW AND DEAL STATE HANDLING FUNCTIONS
-"checkState" is actually a wrapper function for a series of "handle" functions that control different dealing states.
+Each deal state is owned by one scheduler task (see Scheduler.h). Every one of those tasks runs "checkState" first, which tracks
+state transitions, then hands off to the "handle" function for the current state if it owns it.
 */
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma region State Handling
 
-// Always running to make sure DEALR does the right things in the right states.
+// Runs at the start of every state task to make sure DEALR notices state changes, whichever task made them.
 void checkState() {
     unsigned long currentTime = millis(); // Update time in ms every loop.
+    accountStateTime();
 
     // If we change from one state to another, this block lets us do anything that should only happen once during that transition
     if (currentDealState != previousDealState) {
+        logEvent(EVT_DEAL_STATE, previousDealState, currentDealState);
         flags2.newDealState = true;
         overallTimeoutTag = currentTime; // Every time the dealState changes, update overall timeout tag.
         previousDealState = currentDealState;
     }
 
+#if enableEventLog
+    if (currentGamePtr) {
+        uint8_t gameStateId = currentGamePtr->getStateId();
+        if (gameStateId != previousGameStateId) {
+            logEvent(EVT_GAME_STATE, previousGameStateId, gameStateId);
+            previousGameStateId = gameStateId;
+        }
+    }
+#endif
+
     // At any point, we can set "flags3.gameOver" to "true" and the handleGameOver function will help us exit cleanly.
     if (flags3.gameOver) {
+        TRACE_SPAN(SPAN_CHECK_STATE, 0);
         handleGameOver();
     }
 
@@ -519,36 +658,53 @@ void checkState() {
        // if (verbose) {
        //     Serial.println(F("Error in progress (main loop)."));
        // }
+        TRACE_SPAN(SPAN_CHECK_STATE, 1);
         flags4.errorInProgress = false;
         currentDealState = RESET_DEALR;
         updateDisplay();
     }
+}
 
-    switch (currentDealState) {
-        case DEALING: // DEALING handles the process of dealing one or more cards.
-            handleDealingState();
-            break;
+void runLogicTask() {
+    checkState();
 
-        case ADVANCING: // ADVANCING handles movement from one color tag to the next.
-            handleAdvancingState();
-            break;
+    if (currentDealState == IDLE) { // IDLE handles what happens when card dealer resets, is in a menu, or isn't in use.
+        handleIdleState();
+    } else if (currentDealState == RESET_DEALR) {
+        handleResetDealrState(); // Handles resetting state flags when exiting a game or dealing with an error.
+    }
+}
 
-        case INITIALIZING: // INITALIZING handles moving to "red" when starting deal.
-            initializeToRed();
-            break;
+void runMotionTask() {
+    checkState();
 
-        case IDLE: // IDLE handles what happens when card dealer resets, is in a menu, or isn't in use.
-            handleIdleState();
-            break;
+    if (currentDealState == ADVANCING) { // ADVANCING handles movement from one color tag to the next.
+        handleAdvancingState();
+    } else if (currentDealState == INITIALIZING) { // INITALIZING handles moving to "red" when starting deal.
+        initializeToRed();
+    }
+}
 
-        case AWAITING_PLAYER_DECISION: // APD handles what happens when we're waiting for a player to make a decision.
-            handleAwaitingPlayerDecision();
-            break;
+void runDispensingTask() {
+    checkState();
 
-        case RESET_DEALR:
-            handleResetDealrState(); // Handles resetting state flags when exiting a game or dealing with an error.
-            break;
+    if (currentDealState == DEALING) { // DEALING handles the process of dealing one or more cards.
+        handleDealingState();
+    }
+}
+
+void runDisplayTask() {
+    checkState();
+
+    if (currentDealState == AWAITING_PLAYER_DECISION) { // APD handles what happens when we're waiting for a player to make a decision.
+        handleAwaitingPlayerDecision();
+    }
+    checkTimeouts(); // This function tracks a few overall time-out circumstances (like, when the DEALR should go to sleep because it's bored!)
+}
 
+void runSensingTask() {
+    if (flags1.throwingCard) {
+        pollCraw(); // Keep watching the craw during the flywheel spin-up and any other delay while a card is in flight.
     }
 }
 
@@ -618,6 +774,7 @@ void dealSingleCard(uint8_t amount) {
 
     // When "chaotically dealing" in rigged games, we can deal several cards in a row, but want to avoid dealing more than three in a row (suspicious).
     if (consecutiveDeals < 3) {
+        TRACE_SPAN(SPAN_THROW, amount);
         while (!flags1.cardDealt) {
             cardDispensingActions(amount);
             if (flags4.errorInProgress) {
@@ -669,11 +826,12 @@ void cardDispensingActions(uint8_t &amount) {
 void prepareForDeal() {
     unsigned long currentTime = millis();
 
+    flags3.cardLeftCraw = false;     // Flag for whether or not the card has exited the DEALR's mouth. Cleared before the spin-up, since the craw is polled while we wait.
+    accountStateTime();
     flags1.throwingCard = true; // Set flags1.throwingCard tag to "true".
     flywheelOn(true);    // Run flywheel forward.
 
     delay(100);               // Time for flywheel to speed up.
-    flags3.cardLeftCraw = false;     // Flag for whether or not the card has exited the DEALR's mouth.
     throwStart = currentTime; // Tag the start of the throw to track deal time-out.
     slideStep = 0;            // If starting new deal, reset feed motor switch case step to 0.
     previousSlideStep = -1;   // Reset previousSlideStep to be different from slideStep.
@@ -704,6 +862,7 @@ void initializeToRed() // When we start dealing, we don't know where we are, so
 
     if (currentTime - initializationStart > errorTimeout) // If it takes too long for us to initialize, throw and error.
     {
+        reportError(ERR_INIT_TIMEOUT);
         rotateStop();
         errorStartTime = currentTime;
         currentDisplayState = ERROR;
@@ -775,14 +934,17 @@ void fineAdjustCheck() {
         }
     }
 
-    while (activeColor < 1) // While we're seeing no tags (black), rotate at low speed to detect what color we saw spike.
     {
-        colorScan();
-        handleRotationAdjustments(); // Handles which direction we correct towards.
-        handleFineAdjustTimeout();
+        TRACE_SPAN(SPAN_FINE_ADJUST, previousActiveColor);
+        while (activeColor < 1) // While we're seeing no tags (black), rotate at low speed to detect what color we saw spike.
+        {
+            colorScan();
+            handleRotationAdjustments(); // Handles which direction we correct towards.
+            handleFineAdjustTimeout();
+        }
+        rotateStop(); // At this point we have a stable active color. We stop and then make decisions about whether or not we deal a card, depending on game states.
     }
-
-    rotateStop(); // At this point we have a stable active color. We stop and then make decisions about whether or not we deal a card, depending on game states.
+    logEvent(EVT_TAG, activeColor, previousActiveColor);
 
     if (!flags1.dealInitialized) {
         handleInitializingStateInAdjust(); // If we're still in the initializing phase before a deal, this handles decision-making after the fine-adjust.
@@ -839,6 +1001,7 @@ void handleAdvancingStateInAdjust() {
 
     if (activeColor == 1 && previousActiveColor == 1 && !flags3.postDeal) // && !taglessGame     If we've done a full circle and hit red a second time in a row, we know we're missing tags! Throw an error.
     {
+        reportError(ERR_NEED_TAGS);
         flags4.errorInProgress = true;
         while (!flags2.scrollingComplete) {
             displayErrorMessage("EROR NEED TAGS");
@@ -1116,7 +1279,9 @@ void handleIdleState() // Handles what happens in the "IDLE" dealing state.
 void handleGameOver() // Handles when "game over" has been declared by initiating a reset.
 {
     moveOffActiveColor(CW); // Rotate clockwise
+    logEvent(EVT_STACK, freeSramNow(), stackLowWater()); // A whole game has been played, so this is a good measure of real headroom.
     currentGamePtr = nullptr;
+    clearGameSnapshot();
     flags3.gameOver = false;
     flags4.toolsMenuActive = false; // Switching to select game menu. Deactivating tool menu.
     flags4.gamesExit = true;
@@ -1213,6 +1378,9 @@ BUTTONS AND SENSOR-HANDLING FUNCTIONS
 void checkButton(int buttonPin, unsigned long& lastPress, int& lastButtonState, unsigned long& pressTime, bool& longPressFlag, uint16_t longPressDuration, void (*onRelease)(), void (*onLongPress)()) // This demanding function handles everything related to button-pushing in DEALR.
 {
     int currentButtonState = digitalRead(buttonPin); // Read the current button state.
+    if (currentButtonState != lastButtonState) {
+        recordInput(buttonPin, currentButtonState);
+    }
 
     if (currentButtonState == LOW) // If the button has been pressed...
 
@@ -1225,10 +1393,7 @@ void checkButton(int buttonPin, unsigned long& lastPress, int& lastButtonState,
         if (!longPressFlag && millis() - pressTime >= longPressDuration) // Check for long press.
         {
             longPressFlag = true;
-            if (onLongPress != nullptr) {
-                resetTagsOnButtonPress();
-                onLongPress(); // Trigger the long press action.
-            }
+            pressButton(buttonPin, true, onLongPress); // Trigger the long press action.
         }
     }
 
@@ -1236,13 +1401,9 @@ void checkButton(int buttonPin, unsigned long& lastPress, int& lastButtonState,
     {
         lastPress = millis();
 
-        if (!longPressFlag && onRelease != nullptr) // If not a long press, trigger the normal release action.
+        if (!longPressFlag) // If not a long press, trigger the normal release action.
         {
-            resetTagsOnButtonPress();
-            onRelease(); // Trigger the release action.
-            if (currentDisplayState != SCROLL_PLACE_TAGS_TEXT) {
-                flags3.buttonInitialization = true; // A button has been pressed, so we know not to start the screensaver blinking animation, except when we've hit "back" all the way to the beginning.
-            }
+            pressButton(buttonPin, false, onRelease);
         }
         longPressFlag = false; // Reset the long-press flag after release
     }
@@ -1250,6 +1411,19 @@ void checkButton(int buttonPin, unsigned long& lastPress, int& lastButtonState,
     lastButtonState = currentButtonState; // Update the last button state
 }
 
+// Runs the action for a button press. The Serial console uses this too, so injected presses behave exactly like real ones.
+void pressButton(int buttonPin, bool longPress, void (*action)()) {
+    logEvent(EVT_BUTTON, buttonPin, longPress);
+    if (action == nullptr) {
+        return;
+    }
+    resetTagsOnButtonPress();
+    action();
+    if (!longPress && currentDisplayState != SCROLL_PLACE_TAGS_TEXT) {
+        flags3.buttonInitialization = true; // A button has been pressed, so we know not to start the screensaver blinking animation, except when we've hit "back" all the way to the beginning.
+    }
+}
+
 // Go back. TODO: move to differnet region.
 void exitButtonAction() {
     if (currentDealState != IDLE) {
@@ -1257,6 +1431,7 @@ void exitButtonAction() {
             flags4.toolsExit = true;
         } else {
             flags4.gamesExit = true;
+            clearGameSnapshot(); // Leaving on purpose, so don't pick the game up again at the next boot.
         }
         displayFace("EXIT");
         rotateStop();
@@ -1394,6 +1569,7 @@ void onButton4LongPress() {
 }
 
 void resetTagsOnButtonPress() {
+    exitLowPower();                  // Bring the display, servo and motor driver back before the button's action runs.
     overallTimeoutTag = millis();    // Reset tag for overall timeout every time button is pressed.
     scrollDelayTime = 0;             // Force any scrolling text to start scrolling immediately.
     flags2.scrollingStarted = false;        // Reset flags2.scrollingStarted tag.
@@ -1432,6 +1608,7 @@ void pollCraw() {
         cardInCraw = digitalRead(CARD_SENS);
         if (cardInCraw != previousCardInCraw) // detect a change in craw sensor
         {
+            logEvent(EVT_CRAW, cardInCraw == LOW);
             if (cardInCraw == LOW) {
                 // Serial.println(F("New card in craw!"));
                 flags3.cardLeftCraw = false;
@@ -1455,11 +1632,14 @@ void colorScan() {
 
 // Checks the color sensing board to see what color we're looking at, and assigns that to be "activeColor".
 void colorRead(uint16_t blackBaseline) {
+    PROFILE_SCOPE(PROF_COLOR_READ);
     static uint8_t stableColorCount = 0; // Counter to track stability of color readings
     static uint8_t bufferIndex = 0;      // Index for the circular buffer
 
     uint16_t r, g, b, c;
     sensor.getRawData(&r, &g, &b, &c);
+    recordSensorSample(r, g, b, c);
+    onSensorRead(); // Any display frame that was held back goes out now, while the sensor integrates the next sample.
     totalColorValue = r + g + b;
 
     // Serial.print("Red: ");
@@ -1521,10 +1701,10 @@ void colorRead(uint16_t blackBaseline) {
 }
 
 bool checkForColorSpike(uint16_t c, uint16_t blackBaseline) {
-    if (!flags2.baselineExceeded && !flags5.adjustInProgress && float(c) >= float(blackBaseline) * 1.6) {
+    if (!flags2.baselineExceeded && !flags5.adjustInProgress && float(c) >= float(blackBaseline) * spikeThreshold) {
         // Serial.println(F("Baseline exceeded!"));
         flags2.baselineExceeded = true;
-    } else if (flags2.baselineExceeded && float(c) < float(blackBaseline) * 1.6) {
+    } else if (flags2.baselineExceeded && float(c) < float(blackBaseline) * spikeThreshold) {
         // Serial.println(F("Back below baseline."));
         flags2.baselineExceeded = false;
     }
@@ -1627,7 +1807,7 @@ void showGame() {
         for (uint8_t i = 0; i < 4 && i < strlen(buffer); i++) {
             display.writeDigitAscii(i, buffer[i]);
         }
-        display.writeDisplay();
+        writeDisplayFrame();
     }
 }
 
@@ -1643,7 +1823,7 @@ void showTool() // Displays the currently selected tool.
         for (uint8_t i = 0; i < 4; i++) {
             display.writeDigitAscii(i, buffer[i]);
         }
-        display.writeDisplay();
+        writeDisplayFrame();
     }
     if (currentToolsMenu != previousToolsMenu) {
         previousToolsMenu = currentToolsMenu;
@@ -1665,9 +1845,9 @@ void startScrollText(const char* text, uint16_t start, uint16_t delay, uint16_t
 {
     strncpy(message, text, sizeof(message) - 1);
     message[sizeof(message) - 1] = '\0';
-    textStartHoldTime = start;
-    textSpeedInterval = delay;
-    textEndHoldTime = end;
+    scrollStartHold = start;
+    scrollInterval = delay;
+    scrollEndHold = end;
     lastScrollTime = millis();
     flags2.scrollingComplete = false;
     scrollIndex = -1; // Reset the scroll index
@@ -1692,8 +1872,8 @@ void updateScrollText() {
             display.writeDigitAscii(1, message[1]);
             display.writeDigitAscii(2, message[2]);
             display.writeDigitAscii(3, message[3]);
-            display.writeDisplay();
-            scrollDelayTime = textStartHoldTime; // Set delayTime to hold interval
+            writeDisplayFrame();
+            scrollDelayTime = scrollStartHold; // Set delayTime to hold interval
             scrollIndex++;
         } else if (scrollIndex < static_cast<int>(strlen(message)) - 3) {
             // Scroll the text
@@ -1702,8 +1882,8 @@ void updateScrollText() {
             display.writeDigitAscii(1, message[scrollIndex + 1]);
             display.writeDigitAscii(2, message[scrollIndex + 2]);
             display.writeDigitAscii(3, message[scrollIndex + 3]);
-            display.writeDisplay();
-            scrollDelayTime = textSpeedInterval; // Set delayTime to scroll interval
+            writeDisplayFrame();
+            scrollDelayTime = scrollInterval; // Set delayTime to scroll interval
             scrollIndex++;
         } else {
             // Hold the last frame for one second
@@ -1712,8 +1892,8 @@ void updateScrollText() {
             display.writeDigitAscii(1, message[strlen(message) - 3]);
             display.writeDigitAscii(2, message[strlen(message) - 2]);
             display.writeDigitAscii(3, message[strlen(message) - 1]);
-            display.writeDisplay();
-            scrollDelayTime = textEndHoldTime; // Set delayTime to hold interval
+            writeDisplayFrame();
+            scrollDelayTime = scrollEndHold; // Set delayTime to hold interval
             scrollIndex = -1;                  // Reset the scroll index to start again
             messageRepetitions++;              // How many times has the full message repeated, in messages that only repeat x times before advancing
             messageLine++;                     // When one message has several lines, used to increment through
@@ -1745,7 +1925,7 @@ void displayFace(const char* word) // Displays a single 4-letter word.
             display.writeDigitAscii(i, word[i]);
         }
     }
-    display.writeDisplay();
+    writeDisplayFrame();
 }
 
 void scrollMenuText(const char* text) // Helper function that receives text from "showGame()" and "showTool()"
@@ -1759,6 +1939,7 @@ void scrollMenuText(const char* text) // Helper function that receives text from
 
 // A catch-all display-updating switch-case that controls what should be displayed on the 14-segment timer when called.
 void updateDisplay() {
+    PROFILE_SCOPE(PROF_UPDATE_DISPLAY);
     if (currentDisplayState != previousDisplayState) {
         flags2.scrollingStarted = false;
         flags2.scrollingComplete = false;
@@ -1766,6 +1947,7 @@ void updateDisplay() {
         scrollIndex = -1;
         currentFrameIndex = 0;
         lastFrameTime = millis();
+        logEvent(EVT_DISPLAY, previousDisplayState, currentDisplayState);
         previousDisplayState = currentDisplayState;
         //if (verbose) {
           //  Serial.print(F("Display state changed to: "));
@@ -1879,6 +2061,7 @@ void displayErrorMessage(const char* message) // Displays an error message, then
         startScrollText(message, 1000, textSpeedInterval, 1000);
     }
     while (!flags2.scrollingComplete) {
+        feedWatchdog();
         updateScrollText();
         if (messageRepetitions > 0) {
             flags2.scrollingComplete = true;
@@ -2038,10 +2221,14 @@ void advanceMenu() {
             currentGamePtr = nullptr;
 
             if (currentGame < totalGames) { // A game is selected
+                clearGameSnapshot();        // A new game replaces any saved one.
                 currentGamePtr = gameRegistry.getGame(currentGame);
                 if (currentGamePtr) {
                     bool startDealing = currentGamePtr->initialize(); // Call game's setup method
-                    if (startDealing) {
+                    uint8_t capabilities = currentGamePtr->getStartupCapabilities();
+                    if (startDealing && (capabilities & GAME_NO_INITIAL_DEAL) && (capabilities & GAME_SELF_REGISTERS)) {
+                            startAtGamePrompt(); // Nothing to deal and no need for red, so skip the homing lap.
+                    } else if (startDealing) {
                             // Game selected, setup done, start dealing
                             currentDisplayState = DEAL_CARDS;
                             currentDealState = DEALING;
@@ -2056,6 +2243,7 @@ void advanceMenu() {
                 } else {
                     // Error getting game pointer
                  //   if (verbose) Serial.println(F("ERROR: Invalid game pointer selected!"));
+                    reportError(ERR_BAD_GAME);
                     currentDisplayState = ERROR; // Go to error state
                     currentDealState = IDLE;
                 }
@@ -2066,6 +2254,7 @@ void advanceMenu() {
             } else {
                 // Should not happen
                 //if (verbose) Serial.println(F("ERROR: Invalid currentGame index in advanceMenu!"));
+                reportError(ERR_BAD_GAME);
                 currentDisplayState = ERROR;
                 currentDealState = IDLE;
             }
@@ -2109,6 +2298,9 @@ void advanceMenu() {
                 flags4.fullExit = true;
                 currentDealState = RESET_DEALR;
                 updateDisplay();
+            } else if (flags4.toolsMenuActive && currentToolsMenu == 5) // DIAGNOSTICS
+            {
+                diagnosticsViewer();
             }
             flags3.insideDealrTools = true;
             break;
@@ -2301,7 +2493,9 @@ void slideCard(uint8_t &amount) {
                 previousSlideStep = -1;
                 feedCard.write(90);
                 slideStep = 0;
+                accountStateTime();
                 flags1.throwingCard = false;
+                logEvent(EVT_CARD, activeColor, currentTime - throwStart);
                 // if (!flags4.errorInProgress) {
                     flags1.cardDealt = true;
                 // }
@@ -2314,6 +2508,11 @@ void slideCard(uint8_t &amount) {
 
 // Starts rotation CW or CCW at a specified speed.
 void rotate(uint8_t rotationSpeed, bool direction) {
+    exitLowPower(); // The motor driver is in standby while idling.
+    if (stopped) {
+        motionStartedAt = millis(); // The watchdog allows rotation to last up to watchdogMotionLimit.
+        accountStateTime();         // Time up to here wasn't motion.
+    }
     analogWrite(MOTOR_2_PWM, rotationSpeed);
 
     // CW = "True"
@@ -2342,6 +2541,7 @@ void rotate(uint8_t rotationSpeed, bool direction) {
 // Stops yaw rotation and toggles a few rotating states to false.
 void rotateStop() {
     if (!stopped) {
+        accountStateTime(); // Time up to here was motion.
         stopped = true;
         flags1.rotatingCW = false;
         flags1.rotatingCCW = false;
@@ -2349,10 +2549,12 @@ void rotateStop() {
         digitalWrite(MOTOR_2_PIN_2, LOW);
         delay(20); // Slight delay while motors stop.
     }
+    flushDisplayFrame(); // Stopped, so anything held back for the colour sensor can go out.
 }
 
 void flywheelOn(bool direction) // Turns flywheel on. Accepts "true" for forward, "false" for reverse.
 {
+    exitLowPower(); // The motor driver is in standby and the feed servo is detached while idling.
     if (direction == false) {
         analogWrite(MOTOR_1_PWM, flywheelMaxSpeed);
         digitalWrite(MOTOR_1_PIN_1, HIGH);
@@ -2405,6 +2607,7 @@ void colorTuner() // Controls the "color tuning" operation that locks down RGB v
     const int numMessages = sizeof(messages) / sizeof(messages[0]);
 
     while (!flags2.scrollingComplete) {
+        feedWatchdog(); // Waiting on a person, not on DEALR.
         if (messageRepetitions >= 1) {
             messageRepetitions = 0;
             startScrollText(messages[messageCounter], textStartHoldTime, textSpeedInterval, textEndHoldTime);
@@ -2418,7 +2621,7 @@ void colorTuner() // Controls the "color tuning" operation that locks down RGB v
             flags2.scrollingComplete = true;
             flags2.scrollingStarted = false;
             while (digitalRead(BUTTON_PIN_1) == LOW || digitalRead(BUTTON_PIN_2) == LOW || digitalRead(BUTTON_PIN_3) == LOW) {
-                // Wait for "confirm" button to be released before proceeding.
+                feedWatchdog(); // Wait for "confirm" button to be released before proceeding.
             };
             break;
         } else if (digitalRead(BUTTON_PIN_4) == LOW) {
@@ -2461,6 +2664,7 @@ void recordColors(int startIndex) // This function scans, records, and saves col
         bool buttonReleased = true;
 
         while (!buttonPressed) {
+            feedWatchdog();
             if (digitalRead(BUTTON_PIN_4) == LOW) { // Allows the "back" button to cancel this operation
                 flags4.toolsExit = true;
                 currentDealState = RESET_DEALR;
@@ -2538,6 +2742,7 @@ void uvSensorTuner() // Controls the "uv tuning" operation that locks down the t
     const int numMessages = sizeof(messages) / sizeof(messages[0]);
 
     while (!flags2.scrollingComplete) {
+        feedWatchdog(); // Waiting on a person, not on DEALR.
         if (messageRepetitions >= 1) {
             messageRepetitions = 0;
             startScrollText(messages[messageCounter], textStartHoldTime, textSpeedInterval, textEndHoldTime);
@@ -2549,7 +2754,7 @@ void uvSensorTuner() // Controls the "uv tuning" operation that locks down the t
             flags2.scrollingComplete = true;
             flags2.scrollingStarted = false;
             while (digitalRead(BUTTON_PIN_1) == LOW || digitalRead(BUTTON_PIN_2) == LOW || digitalRead(BUTTON_PIN_3) == LOW) {
-                // Wait for "confirm" button to be released before proceeding.
+                feedWatchdog(); // Wait for "confirm" button to be released before proceeding.
             };
             break;
         } else if (digitalRead(BUTTON_PIN_4) == LOW) {
@@ -2624,6 +2829,77 @@ void resetEEPROMToDefaults() // Function for resetting EEPROM values to defaults
 
     EEPROM.write(EEPROM_VERSION_ADDR, EEPROM_VERSION); // Write the version byte to indicate EEPROM has been initialized
 }
+
+void diagnosticsViewer() // Scrolls the lines of every diagnostics page. B steps forward, Y steps back, G re-reads the line (and dumps every page over Serial if enabled), R exits.
+{
+    const uint8_t numPages = sizeof(diagnosticsPages) / sizeof(diagnosticsPages[0]);
+    uint8_t page = 0;
+    uint8_t line = 0;
+    bool refresh = true;
+    char buffer[sizeof(message)];
+
+    while (digitalRead(BUTTON_PIN_1) == LOW) {
+        feedWatchdog(); // Wait for the button that opened the tool to be released.
+    }
+
+    while (true) {
+        feedWatchdog();
+        DiagnosticsPage current;
+        memcpy_P(&current, &diagnosticsPages[page], sizeof(current));
+
+        if (refresh) {
+            refresh = false;
+            current.formatLine(line, buffer, sizeof(buffer));
+            startScrollText(buffer, textStartHoldTime, textSpeedInterval, textEndHoldTime);
+        }
+        updateScrollText();
+
+        if (digitalRead(BUTTON_PIN_2) == LOW) { // Blue: next line, moving on to the next page after the last one.
+            if (++line >= current.lineCount()) {
+                line = 0;
+                page = (page + 1) % numPages;
+            }
+            refresh = true;
+        } else if (digitalRead(BUTTON_PIN_3) == LOW) { // Yellow: previous line.
+            if (line > 0) {
+                line--;
+            } else {
+                page = (page + numPages - 1) % numPages;
+                DiagnosticsPage previous;
+                memcpy_P(&previous, &diagnosticsPages[page], sizeof(previous));
+                line = previous.lineCount() - 1;
+            }
+            refresh = true;
+        } else if (digitalRead(BUTTON_PIN_1) == LOW) { // Green: refresh.
+#if enableSerialReports
+            for (uint8_t p = 0; p < numPages; p++) {
+                DiagnosticsPage dumped;
+                memcpy_P(&dumped, &diagnosticsPages[p], sizeof(dumped));
+                if (dumped.dump != nullptr) {
+                    dumped.dump();
+                    continue;
+                }
+                for (uint8_t l = 0; l < dumped.lineCount(); l++) {
+                    dumped.formatLine(l, buffer, sizeof(buffer));
+                    Serial.println(buffer);
+                }
+            }
+#endif
+            refresh = true;
+        } else if (digitalRead(BUTTON_PIN_4) == LOW) { // Red: back to the tools menu.
+            flags4.toolsExit = true;
+            currentDealState = RESET_DEALR;
+            updateDisplay();
+            return;
+        }
+
+        if (refresh) {
+            while (digitalRead(BUTTON_PIN_1) == LOW || digitalRead(BUTTON_PIN_2) == LOW || digitalRead(BUTTON_PIN_3) == LOW) {
+                feedWatchdog(); // Wait for the button to be released before showing the next line.
+            }
+        }
+    }
+}
 #pragma endregion DEALR Tools
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2660,6 +2936,7 @@ void handleThrowingTimeout(unsigned long currentTime) {
 
     if (retractCompleted) {
         retractCompleted = false;
+        reportError(ERR_THROW_TIMEOUT);
         if (currentToolsMenu == 1) {
             // flags4.errorInProgress = true;
             // shufflingCards = false;
@@ -2693,17 +2970,29 @@ void resetThrowCardState() {
     previousSlideStep = -1;
     feedCard.write(90);
     slideStep = 0;
+    accountStateTime();
     flags1.throwingCard = false;
     flags1.cardDealt = true;
     overallTimeoutTag = millis();
     delay(10);
 }
 
+// Every error path comes through here, so there's one place to hook in anything that should happen when DEALR gives up on something.
+void reportError(errorCode code) {
+    logEvent(EVT_ERROR, code, currentDealState);
+    logEvent(EVT_STACK, freeSramNow(), stackLowWater());
+#if enableFlightRecorder
+    flushFlightRecorder(code);
+#endif
+    EEPROM.update(BOOT_FAULT_ADDR, BOOT_FAULT_SET); // Ask the next boot to run the motor self-check, even with fast boot on.
+}
+
 void handleFineAdjustTimeout() // Handles timeout for fine adjustment moves.
 {
     unsigned long currentTime = millis();
 
     if (currentTime - adjustStart > errorTimeout && currentDealState != AWAITING_PLAYER_DECISION) {
+        reportError(ERR_ADJUST_TIMEOUT);
         errorStartTime = currentTime;
         currentDisplayState = ERROR;
         currentDealState = IDLE;
@@ -2836,5 +3125,110 @@ RGBColor readColorFromEEPROM(int index) // Helper function used in loadColorsFro
 RGBColor getBlackColorFromEEPROM() {
     return readColorFromEEPROM(0); // If we have black stored at index 0, this will retrieve it
 }
+
+uint8_t eepromChecksum(uint16_t addr, uint8_t length) // CRC-8 over length bytes of EEPROM.
+{
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= EEPROM.read(addr + i);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+uint8_t gameSnapshotChecksum(uint8_t size) // CRC-8 over the game index, size and data of the snapshot in EEPROM.
+{
+    return eepromChecksum(GAME_SNAPSHOT_ADDR + 1, GAME_SNAPSHOT_HEADER - 1 + size);
+}
+
+void saveGameSnapshot(const void* data, uint8_t size) // Games call this at round boundaries. Only changed bytes are written, so a round costs little EEPROM wear.
+{
+    if (size > GAME_SNAPSHOT_MAX_DATA) {
+        return;
+    }
+    EEPROM.update(GAME_SNAPSHOT_ADDR, 0); // Invalid until the checksum is written, in case power goes mid-save.
+    EEPROM.update(GAME_SNAPSHOT_ADDR + 1, currentGame);
+    EEPROM.update(GAME_SNAPSHOT_ADDR + 2, size);
+    for (uint8_t i = 0; i < size; i++) {
+        EEPROM.update(GAME_SNAPSHOT_ADDR + GAME_SNAPSHOT_HEADER + i, ((const uint8_t*)data)[i]);
+    }
+    EEPROM.update(GAME_SNAPSHOT_ADDR + GAME_SNAPSHOT_HEADER + size, gameSnapshotChecksum(size));
+    EEPROM.update(GAME_SNAPSHOT_ADDR, GAME_SNAPSHOT_MAGIC);
+}
+
+bool loadGameSnapshot(void* data, uint8_t size) {
+    if (EEPROM.read(GAME_SNAPSHOT_ADDR) != GAME_SNAPSHOT_MAGIC || EEPROM.read(GAME_SNAPSHOT_ADDR + 1) != currentGame
+        || EEPROM.read(GAME_SNAPSHOT_ADDR + 2) != size || size > GAME_SNAPSHOT_MAX_DATA
+        || EEPROM.read(GAME_SNAPSHOT_ADDR + GAME_SNAPSHOT_HEADER + size) != gameSnapshotChecksum(size)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < size; i++) {
+        ((uint8_t*)data)[i] = EEPROM.read(GAME_SNAPSHOT_ADDR + GAME_SNAPSHOT_HEADER + i);
+    }
+    return true;
+}
+
+void clearGameSnapshot() {
+    EEPROM.update(GAME_SNAPSHOT_ADDR, 0);
+}
+
+bool resumeSavedGame() // Goes straight to the saved game's prompt, the way it is after a normal deal has finished.
+{
+    if (EEPROM.read(GAME_SNAPSHOT_ADDR) != GAME_SNAPSHOT_MAGIC) {
+        return false;
+    }
+    currentGame = EEPROM.read(GAME_SNAPSHOT_ADDR + 1);
+    currentGamePtr = gameRegistry.getGame(currentGame);
+    if (!currentGamePtr || !currentGamePtr->resume()) {
+        currentGamePtr = nullptr;
+        currentGame = 0;
+        clearGameSnapshot();
+        return false;
+    }
+    flags3.buttonInitialization = true;
+    startAtGamePrompt();
+    return true;
+}
+
+void saveSeatRing(const uint8_t* colors, uint8_t count) // Only changed bytes are written, so registering the same table again costs no EEPROM wear.
+{
+    if (count > SEAT_RING_MAX_SEATS) {
+        return;
+    }
+    EEPROM.update(SEAT_RING_ADDR, 0); // Invalid until the checksum is written, in case power goes mid-save.
+    EEPROM.update(SEAT_RING_ADDR + 1, count);
+    for (uint8_t i = 0; i < count; i++) {
+        EEPROM.update(SEAT_RING_ADDR + SEAT_RING_HEADER + i, colors[i]);
+    }
+    EEPROM.update(SEAT_RING_ADDR + SEAT_RING_HEADER + count, eepromChecksum(SEAT_RING_ADDR + 1, count + 1));
+    EEPROM.update(SEAT_RING_ADDR, SEAT_RING_MAGIC);
+}
+
+uint8_t loadSeatRing(uint8_t* colors, uint8_t room) {
+    uint8_t count = EEPROM.read(SEAT_RING_ADDR + 1);
+    if (EEPROM.read(SEAT_RING_ADDR) != SEAT_RING_MAGIC || count == 0 || count > room || count > SEAT_RING_MAX_SEATS
+        || EEPROM.read(SEAT_RING_ADDR + SEAT_RING_HEADER + count) != eepromChecksum(SEAT_RING_ADDR + 1, count + 1)) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        colors[i] = EEPROM.read(SEAT_RING_ADDR + SEAT_RING_HEADER + i);
+    }
+    return count;
+}
+
+void clearSeatRing() {
+    EEPROM.update(SEAT_RING_ADDR, 0);
+}
+
+void startAtGamePrompt() // The flags a finished main deal leaves behind, so the game's prompts and deals work as usual.
+{
+    flags1.dealInitialized = true;
+    flags3.postDeal = true;
+    flags4.postDealRemainderHandled = true;
+    currentDisplayState = DEAL_CARDS;
+    currentDealState = AWAITING_PLAYER_DECISION;
+}
 #pragma endregion EEPROM
 #pragma endregion FUNCTIONS
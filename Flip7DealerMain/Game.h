@@ -16,6 +16,9 @@
 #include "Config.h"
 #include "Faces.h"
 #include "ColorNames.h"
+#include "Profiler.h"
+#include "Tracing.h"
+#include "Pacing.h"
 
 // Forward declare globals
 extern dealState currentDealState;
@@ -30,8 +33,10 @@ extern uint8_t messageRepetitions;
 extern uint8_t activeColor;
 extern const uint8_t mediumSpeed;
 extern const uint8_t highSpeed;
+extern const uint8_t debounceCount;
 extern uint16_t scrollDelayTime;
 extern char message[];
+extern char roundStatsMessage[]; // RoundStats.h, when enableRoundStats is on
 
 // Forward declare core functions games might need
 void dealSingleCard(uint8_t amount);
@@ -47,6 +52,29 @@ void handleFlipCard(); // Example of a core function a game might trigger
 void rotate(uint8_t rotationSpeed, bool direction);
 void rotateStop();
 void colorScan();
+void feedWatchdog();
+void reportError(errorCode code);
+void displayErrorMessage(const char* message);
+void saveGameSnapshot(const void* data, uint8_t size);
+bool loadGameSnapshot(void* data, uint8_t size);
+void clearGameSnapshot();
+void saveSeatRing(const uint8_t* colors, uint8_t count);
+uint8_t loadSeatRing(uint8_t* colors, uint8_t room);
+void clearSeatRing();
+void resetRoundStats();
+void resetGameStats();
+void showRoundStats(bool wholeGame);
+#if enableDealerLink && !dealerLinkFollower
+bool linkHello();                                   // DealerLink.h, on the leader
+uint8_t linkRegister(uint8_t* colors, uint8_t room);
+void linkSeek(uint8_t color);
+bool linkDeal(uint8_t color, uint8_t amount);
+#endif
+
+// Startup capabilities, for getStartupCapabilities(). A game with both is started at its first prompt, without
+// turning to the red tag and running a main deal first.
+#define GAME_NO_INITIAL_DEAL (1 << 0) // The game has no main deal. It deals its cards from its own prompts.
+#define GAME_SELF_REGISTERS (1 << 1)  // The game finds the players' tags itself, so it doesn't need DEALR to start at red.
 
 // Base class for all games
 class Game {
@@ -100,11 +128,49 @@ class Game {
         }
     }
 
+    // What the game does for itself when it starts, as GAME_ flags (see above).
+    virtual uint8_t getStartupCapabilities() const {
+        return 0; // Default: DEALR turns to red and deals the main deal
+    }
+
     // Does this game involve flipping a card after the main deal?
     virtual bool requiresFlipCard() const {
         return false; // Default: No
     }
 
+    // Returns the game's own state (its GameState enum, for example) so diagnostics can follow it.
+    virtual uint8_t getStateId() const {
+        return 0; // Default: the game has no states worth reporting
+    }
+
+    // True while players are entering scores, so RoundStats.h doesn't count that time as waiting on their decisions.
+    virtual bool isScoring() const {
+        return false; // Default: the game doesn't keep score on DEALR
+    }
+
+    // Changes whenever the game puts a new question to the table, so Pacing.h only times the first press after it.
+    // Presses that step through a choice (a target score, a player to pick) leave it as it is.
+    virtual uint8_t getPromptId() const {
+        return getStateId(); // Default: every state is one question
+    }
+
+    // Called at boot when this game saved a snapshot with saveGameSnapshot() before a reset. Restore it with
+    // loadGameSnapshot() and return true to carry on from the game's prompt, or false to go to the menu as usual.
+    virtual bool resume() {
+        return false; // Default: the game can't be resumed
+    }
+
+    // Players and scores, so diagnostics can read them without knowing the game.
+    virtual uint8_t getPlayerCount() const {
+        return 0; // Default: the game doesn't track players
+    }
+    virtual uint8_t getPlayerColor(uint8_t player) const {
+        return 0;
+    }
+    virtual int16_t getPlayerScore(uint8_t player) const {
+        return 0;
+    }
+
 
     // ===== Overridable Internals =====
     // These methods take care of complicated backend stuff
@@ -132,7 +198,7 @@ class Game {
                 nextIndex = displayMessageIndex % messageCount;
                 const char* thisMessage = messages[nextIndex];
                 //Serial.println("Updating message");
-                startScrollText(thisMessage, textStartHoldTime, textSpeedInterval, textEndHoldTime);
+                startScrollText(thisMessage, paced(textStartHoldTime), paced(textSpeedInterval), paced(textEndHoldTime));
                 scrollingStarted = true;
             }
         }
@@ -142,11 +208,21 @@ class Game {
 
     // Internal function dispatch buttons then restart scrolling text
     virtual void _handleButtonPress(int button) {
+        notePlayerResponse();
+        uint8_t promptBefore = getPromptId();
+
         // Call the subclass's internal method.
-        handleButtonPress(button);
+        {
+            PROFILE_SCOPE(PROF_GAME_BUTTON);
+            TRACE_SPAN(SPAN_GAME_BUTTON, button);
+            handleButtonPress(button);
+        }
 
         // Start up scrolling messages
         resetScrollingMessages();
+        if (currentDealState == AWAITING_PLAYER_DECISION && !isScoring() && getPromptId() != promptBefore) {
+            startResponseTimer(); // A new question. Taps while scoring or choosing aren't responses.
+        }
     }
 
     // Internal function to run when deal ends, which calls when it finishes running internal code
@@ -156,6 +232,7 @@ class Game {
 
         // Start up scrolling messages
         resetScrollingMessages();
+        startResponseTimer();
     }
 
   protected:
@@ -165,6 +242,7 @@ class Game {
     int displayMessageIndex = 0;
 
     void dispenseCards(uint8_t amount=1) {
+        feedWatchdog(); // Dealing has its own timeout (throwExpiration), so it gets a fresh watchdog period.
         // for (uint8_t i = 0; i < amount; ++i) {
         //     _dealSingleCard();
         // }
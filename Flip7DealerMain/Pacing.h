@@ -0,0 +1,68 @@
+#ifndef PACING_H
+#define PACING_H
+
+//
+//  Adaptive pacing. The scroll timings in Config.h and the short holds in games (showing a player's colour while
+//  registering, pausing after each card) are sized for a table that is new to DEALR. A table that knows the prompts
+//  answers them long before the text has scrolled past, and ends up waiting on DEALR instead.
+//
+//  So DEALR times how long the table takes to press a button once a game prompt is ready, and keeps a running
+//  average of it. Games scale their scroll timings and holds by pacePercent(): 100% (the Config.h values) for a
+//  slow table, down to pacingFastestPercent for a table that answers within pacingFastResponse. One long
+//  hesitation pulls the average back up, so the text slows down again for whoever needs it.
+//
+//  The average carries over from game to game until DEALR is switched off. Turn this off with adaptivePacing in
+//  Config.h.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+
+const uint8_t pacingFastestPercent = 60;         // Shortest the timings get, as a percentage of the Config.h values.
+const unsigned long pacingFastResponse = 1500;   // A table averaging this response time (ms) or less gets the fastest pacing.
+const unsigned long pacingSlowResponse = 6000;   // A table averaging this (ms) or more gets the Config.h timings.
+const unsigned long pacingLongestSample = 15000; // Longer waits count as this long, so one break doesn't take many prompts to forget.
+
+unsigned long responseAverage = pacingSlowResponse; // Running average of response times, in ms. Starts out slow.
+unsigned long promptReadyAt = 0;                     // When the current prompt was ready for an answer. 0 while there isn't one.
+
+// Percentage of the Config.h timings to use for the current table.
+uint8_t pacePercent() {
+    if (!adaptivePacing || responseAverage >= pacingSlowResponse) {
+        return 100;
+    }
+    if (responseAverage <= pacingFastResponse) {
+        return pacingFastestPercent;
+    }
+    return pacingFastestPercent + (100 - pacingFastestPercent) * (responseAverage - pacingFastResponse) / (pacingSlowResponse - pacingFastResponse);
+}
+
+uint16_t paced(uint16_t ms) {
+    return (uint32_t)ms * pacePercent() / 100;
+}
+
+// Holds that only give people time to read the display. Motion and card timings stay as they are.
+void pacedDelay(uint16_t ms) {
+    delay(paced(ms));
+}
+
+// A game prompt is on the display and the next button press answers it.
+void startResponseTimer() {
+    promptReadyAt = millis();
+}
+
+// A game button was pressed. Adds the time since the prompt was ready to the average, with each new response counting
+// for a quarter.
+void notePlayerResponse() {
+    if (promptReadyAt == 0) {
+        return;
+    }
+    unsigned long response = millis() - promptReadyAt;
+    promptReadyAt = 0;
+    if (response > pacingLongestSample) {
+        response = pacingLongestSample;
+    }
+    responseAverage = responseAverage - responseAverage / 4 + response / 4;
+}
+
+#endif // PACING_H
@@ -0,0 +1,114 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+//
+//  Low-power idle. When DEALR is showing the screensaver, or has sat at a game prompt with nobody touching it
+//  for timeUntilPromptIdle, it:
+//    - detaches the feed servo, so the servo stops holding position,
+//    - puts the motor driver in standby (STNDBY low),
+//    - dims the display and powers down the ADC,
+//    - sleeps the CPU (SLEEP_MODE_IDLE) between loop() passes. Timer0 still wakes it every millisecond, so millis(),
+//      the screensaver animation and scrolling text keep running.
+//  A button pin change wakes it straight away, and so does any button action or motor command. Battery-powered
+//  tables last noticeably longer through a long night. Turn it off with lowPowerIdle in Config.h.
+//
+
+#include <Arduino.h>
+#include <Servo.h>
+#include <Adafruit_LEDBackpack.h>
+#include "Config.h"
+#include "Definitions.h"
+#include "Enums.h"
+
+#ifdef __AVR__
+#include <avr/sleep.h>
+#include <avr/power.h>
+#include <avr/interrupt.h>
+#endif
+
+extern Servo feedCard;
+extern Adafruit_AlphaNum4 display;
+extern dealState currentDealState;
+extern displayState currentDisplayState;
+extern unsigned long overallTimeoutTag;
+extern bool stopped;
+
+const uint8_t activeBrightness = 5; // Display brightness (0-7) while in use.
+const uint8_t idleBrightness = 0;   // Display brightness while idling. Still readable across a dark table.
+
+bool lowPowerActive = false;
+volatile bool buttonWake = false; // Set by the button pin-change interrupt.
+
+// Buttons 1-4 are on A3-A0 (PCINT11-8), so a single pin-change interrupt covers all of them.
+void enableButtonWake() {
+#ifdef __AVR__
+    PCMSK1 |= bit(PCINT8) | bit(PCINT9) | bit(PCINT10) | bit(PCINT11);
+    PCIFR = bit(PCIF1);
+    PCICR |= bit(PCIE1);
+#endif
+}
+
+#ifdef __AVR__
+ISR(PCINT1_vect) {
+    buttonWake = true;
+}
+#endif
+
+bool shouldIdle() {
+    if (!lowPowerIdle || !stopped || flags1.throwingCard) {
+        return false;
+    }
+    if (currentDisplayState == SCREENSAVER) {
+        return true;
+    }
+    return currentDealState == AWAITING_PLAYER_DECISION && millis() - overallTimeoutTag > timeUntilPromptIdle;
+}
+
+void enterLowPower() {
+    lowPowerActive = true;
+    buttonWake = false;
+    feedCard.detach();
+    digitalWrite(STNDBY, LOW);
+    display.setBrightness(idleBrightness);
+#ifdef __AVR__
+    power_adc_disable();
+#endif
+}
+
+// Puts everything back the way it was. Safe to call any time; it does nothing unless DEALR is idling.
+void exitLowPower() {
+    if (!lowPowerActive) {
+        return;
+    }
+    lowPowerActive = false;
+#ifdef __AVR__
+    power_adc_enable();
+#endif
+    display.setBrightness(activeBrightness);
+    digitalWrite(STNDBY, HIGH);
+    feedCard.attach(FEED_SERVO_PIN);
+    feedCard.write(90); // Neutral, so the servo doesn't move when it's attached again.
+}
+
+// Scheduler task: decides whether DEALR should be idling.
+void runPowerTask() {
+    if (buttonWake || !shouldIdle()) {
+        buttonWake = false;
+        exitLowPower();
+    } else if (!lowPowerActive) {
+        enterLowPower();
+    }
+}
+
+// Called at the end of every loop() pass. Sleeps until the next interrupt (normally the next millis() tick).
+void sleepUntilNextTick() {
+    if (!lowPowerActive || buttonWake) {
+        return;
+    }
+#ifdef __AVR__
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+#endif
+}
+
+#endif // POWER_MANAGER_H
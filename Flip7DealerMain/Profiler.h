@@ -0,0 +1,163 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+//
+//  Lightweight latency profiler. Drop PROFILE_SCOPE(section) at the top of a block and the time until the
+//  block exits is measured with micros() and folded into that section's min/max/mean and a log2 histogram.
+//  Everything lives in a fixed table (about 38 bytes per section), and with enableProfiler set to false the
+//  macro compiles away to nothing.
+//
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "Config.h"
+
+enum ProfileSection : uint8_t {
+    PROF_LOOP,           // One pass of loop().
+    PROF_COLOR_READ,     // colorRead(): one sensor read and colour classification.
+    PROF_UPDATE_DISPLAY, // updateDisplay().
+    PROF_GAME_BUTTON,    // The current game's handleButtonPress(), including any moves and deals it starts.
+    NUM_PROFILE_SECTIONS
+};
+
+const char profileSectionNames[NUM_PROFILE_SECTIONS][5] PROGMEM = { "LOOP", "COLR", "DSPL", "GBTN" };
+
+// Bucket 0 holds everything under 64 us, bucket n holds [2^(n+5), 2^(n+6)) us, and the last bucket holds
+// everything from 65 ms up.
+#define PROFILE_BUCKETS 12
+
+struct ProfileStats {
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t totalUs; // Halved together with count when either gets close to overflowing, so the mean survives.
+    uint16_t count;
+    uint16_t buckets[PROFILE_BUCKETS];
+};
+
+#if enableProfiler
+
+ProfileStats profileStats[NUM_PROFILE_SECTIONS];
+
+uint8_t profileBucket(uint32_t us) {
+    uint8_t bucket = 0;
+    us >>= 5;
+    while (us > 1 && bucket < PROFILE_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void profileRecord(uint8_t section, uint32_t us) {
+    ProfileStats& stats = profileStats[section];
+    if (stats.count == 0 || us < stats.minUs) {
+        stats.minUs = us;
+    }
+    if (us > stats.maxUs) {
+        stats.maxUs = us;
+    }
+    if (stats.count == 0xFFFF || stats.totalUs > 0x7FFFFFFF - us) {
+        stats.count >>= 1;
+        stats.totalUs >>= 1;
+    }
+    stats.count++;
+    stats.totalUs += us;
+
+    uint16_t& bucket = stats.buckets[profileBucket(us)];
+    if (bucket < 0xFFFF) {
+        bucket++;
+    }
+}
+
+class ProfileScope {
+  public:
+    explicit ProfileScope(uint8_t section) : section(section), start(micros()) {}
+    ~ProfileScope() { profileRecord(section, micros() - start); }
+
+  private:
+    uint8_t section;
+    unsigned long start;
+};
+
+#define PROFILE_SCOPE(section) ProfileScope profileScope_##section(section)
+
+// Writes a duration in four characters or less: "850U", "4.2M" (ms), "120M", "12S".
+void formatProfileTime(uint32_t us, char* buffer, size_t size) {
+    if (us < 1000) {
+        snprintf(buffer, size, "%uU", (unsigned int)us);
+    } else if (us < 10000) {
+        snprintf(buffer, size, "%u.%uM", (unsigned int)(us / 1000), (unsigned int)(us % 1000 / 100));
+    } else if (us < 1000000) {
+        snprintf(buffer, size, "%uM", (unsigned int)(us / 1000));
+    } else {
+        snprintf(buffer, size, "%uS", (unsigned int)(us / 1000000));
+    }
+}
+
+// Upper edge of the histogram bucket that contains the 90th percentile.
+uint32_t profileP90(const ProfileStats& stats) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) {
+        total += stats.buckets[i];
+    }
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) {
+        seen += stats.buckets[i];
+        if (seen * 10 >= total * 9) {
+            return 64UL << i;
+        }
+    }
+    return 64UL << (PROFILE_BUCKETS - 1);
+}
+
+// Diagnostics page: one line per section, e.g. "COLR 1.1M/1.4M/9.6M P90<2.0M " (min/avg/max).
+uint8_t profilerLineCount() {
+    return NUM_PROFILE_SECTIONS;
+}
+
+void formatProfilerLine(uint8_t line, char* buffer, size_t size) {
+    const ProfileStats& stats = profileStats[line];
+    char name[5], minText[6], avgText[6], maxText[6], p90Text[6];
+    strncpy_P(name, profileSectionNames[line], sizeof(name));
+    formatProfileTime(stats.minUs, minText, sizeof(minText));
+    formatProfileTime(stats.count ? stats.totalUs / stats.count : 0, avgText, sizeof(avgText));
+    formatProfileTime(stats.maxUs, maxText, sizeof(maxText));
+    formatProfileTime(profileP90(stats), p90Text, sizeof(p90Text));
+    snprintf(buffer, size, "%s %s/%s/%s P90<%s ", name, minText, avgText, maxText, p90Text);
+}
+
+#if enableSerialReports
+// Full dump, histogram included. Bucket labels are the bucket's upper edge in microseconds.
+void dumpProfiler() {
+    for (uint8_t s = 0; s < NUM_PROFILE_SECTIONS; s++) {
+        const ProfileStats& stats = profileStats[s];
+        char name[5];
+        strncpy_P(name, profileSectionNames[s], sizeof(name));
+        Serial.print(name);
+        Serial.print(F(" n="));
+        Serial.print(stats.count);
+        Serial.print(F(" min="));
+        Serial.print(stats.minUs);
+        Serial.print(F(" avg="));
+        Serial.print(stats.count ? stats.totalUs / stats.count : 0);
+        Serial.print(F(" max="));
+        Serial.println(stats.maxUs);
+        for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) {
+            Serial.print(F("  <"));
+            if (i == PROFILE_BUCKETS - 1) {
+                Serial.print(F("inf"));
+            } else {
+                Serial.print(64UL << i);
+            }
+            Serial.print(F(": "));
+            Serial.println(stats.buckets[i]);
+        }
+    }
+}
+#endif
+
+#else
+#define PROFILE_SCOPE(section)
+#endif // enableProfiler
+
+#endif // PROFILER_H
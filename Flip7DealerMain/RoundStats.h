@@ -0,0 +1,155 @@
+#ifndef ROUND_STATS_H
+#define ROUND_STATS_H
+
+//
+//  Where the time goes in a game, measured on DEALR itself so no computer is needed. Every stretch of time during a
+//  game is put in one of four buckets:
+//
+//      ROT   The turntable is moving (seeks, steps, fine adjusts, spins).
+//      DEAL  A card is being thrown, from flywheel spin-up to the feed servo returning.
+//      SCOR  Players are entering scores (the game's isScoring()).
+//      WAIT  Anything else, which is mostly DEALR waiting for someone to press a button.
+//
+//  The bucket totals are kept for the current round and for the whole game. The game also keeps totals per dealState
+//  and per game state. Flip7 adds a line like "ROT 18% DEAL 9% WAIT 61% SCOR 12% " to its score screen messages
+//  (the round) and to its game over messages (the whole game). The per-state totals are on the "*6-DIAGNOSTICS" page.
+//
+//  accountStateTime() charges the time since its last call to whatever is happening now. checkState() calls it every
+//  pass, and rotate(), rotateStop() and the card throw call it when they change the bucket, since those can block for
+//  a while without checkState() running. Time outside a game (menus and tools) isn't counted.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Enums.h"
+#include "Game.h"
+
+extern Game* currentGamePtr;
+extern dealState currentDealState;
+extern bool stopped;
+
+#if enableRoundStats
+
+#define NUM_DEAL_STATES (RESET_DEALR + 1)
+#define STATS_GAME_STATES 12 // Game states with their own total. Higher getStateId() values share the last one.
+
+enum StatsBucket : uint8_t {
+    STATS_ROT,
+    STATS_DEAL,
+    STATS_WAIT,
+    STATS_SCOR,
+    NUM_STATS_BUCKETS
+};
+
+const char statsBucketNames[NUM_STATS_BUCKETS][5] PROGMEM = { "ROT", "DEAL", "WAIT", "SCOR" };
+const char dealStateNames[NUM_DEAL_STATES][5] PROGMEM = { "IDLE", "INIT", "DEAL", "ADV", "WAIT", "RST" };
+
+uint32_t roundBucketMs[NUM_STATS_BUCKETS];
+uint32_t gameBucketMs[NUM_STATS_BUCKETS];
+uint32_t dealStateMs[NUM_DEAL_STATES];
+uint32_t gameStateMs[STATS_GAME_STATES];
+unsigned long statsAccountedAt = 0;
+
+char roundStatsMessage[36]; // The shares are rounded down, so they add up to 100% at most and "ROT 25% DEAL 25% WAIT 25% SCOR 25% " is the longest it gets.
+
+StatsBucket currentStatsBucket() {
+    if (flags1.throwingCard) {
+        return STATS_DEAL;
+    }
+    if (!stopped) {
+        return STATS_ROT;
+    }
+    if (currentGamePtr->isScoring()) {
+        return STATS_SCOR;
+    }
+    return STATS_WAIT;
+}
+
+void accountStateTime() {
+    unsigned long now = millis();
+    unsigned long elapsed = now - statsAccountedAt;
+    statsAccountedAt = now;
+    if (!currentGamePtr) {
+        return;
+    }
+    StatsBucket bucket = currentStatsBucket();
+    roundBucketMs[bucket] += elapsed;
+    gameBucketMs[bucket] += elapsed;
+    dealStateMs[currentDealState] += elapsed;
+    uint8_t gameState = currentGamePtr->getStateId();
+    gameStateMs[gameState < STATS_GAME_STATES ? gameState : STATS_GAME_STATES - 1] += elapsed;
+}
+
+void resetRoundStats() {
+    accountStateTime(); // Whatever led up to the reset belongs to the round before.
+    memset(roundBucketMs, 0, sizeof(roundBucketMs));
+}
+
+void resetGameStats() {
+    resetRoundStats();
+    memset(gameBucketMs, 0, sizeof(gameBucketMs));
+    memset(dealStateMs, 0, sizeof(dealStateMs));
+    memset(gameStateMs, 0, sizeof(gameStateMs));
+}
+
+// Fills roundStatsMessage with each bucket's share of the round (or of the whole game), for the game to scroll.
+void showRoundStats(bool wholeGame) {
+    accountStateTime();
+    const uint32_t* bucketMs = wholeGame ? gameBucketMs : roundBucketMs;
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < NUM_STATS_BUCKETS; i++) {
+        total += bucketMs[i];
+    }
+    if (total == 0) {
+        snprintf(roundStatsMessage, sizeof(roundStatsMessage), "NOT TIMED "); // Nothing to split yet, after a watchdog reset for example.
+        return;
+    }
+    char* out = roundStatsMessage;
+    char* end = roundStatsMessage + sizeof(roundStatsMessage);
+    for (uint8_t i = 0; i < NUM_STATS_BUCKETS; i++) {
+        char name[5];
+        strncpy_P(name, statsBucketNames[i], sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+        uint8_t percent = bucketMs[i] * 100ULL / total; // Rounded down, so the shares never add up to more than 100%.
+        out += snprintf(out, end - out, "%s %u%% ", name, percent);
+    }
+}
+
+// Diagnostics page: the whole game's buckets, then each dealState and game state, as minutes:seconds.
+// For example "ROT 2:41 ", "WAIT 31:02 ", "GAME ST 6 4:10 ".
+uint8_t roundStatsLineCount() {
+    uint8_t gameStates = STATS_GAME_STATES;
+    while (gameStates > 0 && gameStateMs[gameStates - 1] == 0) {
+        gameStates--;
+    }
+    return NUM_STATS_BUCKETS + NUM_DEAL_STATES + gameStates;
+}
+
+void formatRoundStatsLine(uint8_t line, char* buffer, size_t size) {
+    accountStateTime();
+    char name[5];
+    uint32_t seconds;
+    if (line < NUM_STATS_BUCKETS) {
+        strncpy_P(name, statsBucketNames[line], sizeof(name));
+        seconds = gameBucketMs[line] / 1000;
+    } else if (line < NUM_STATS_BUCKETS + NUM_DEAL_STATES) {
+        line -= NUM_STATS_BUCKETS;
+        strncpy_P(name, dealStateNames[line], sizeof(name));
+        seconds = dealStateMs[line] / 1000;
+    } else {
+        line -= NUM_STATS_BUCKETS + NUM_DEAL_STATES;
+        seconds = gameStateMs[line] / 1000;
+        snprintf(buffer, size, "GAME ST %u %lu:%02u ", line, (unsigned long)(seconds / 60), (uint8_t)(seconds % 60));
+        return;
+    }
+    snprintf(buffer, size, "%s %lu:%02u ", name, (unsigned long)(seconds / 60), (uint8_t)(seconds % 60));
+}
+
+#else
+void accountStateTime() {}
+void resetRoundStats() {}
+void resetGameStats() {}
+void showRoundStats(bool wholeGame) {}
+#endif // enableRoundStats
+
+#endif // ROUND_STATS_H
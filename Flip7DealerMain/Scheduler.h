@@ -0,0 +1,165 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+//
+//  A small cooperative scheduler. loop() makes one pass over the task table below, and each task declares
+//  how often it wants to run (period) and how long one run is allowed to take (budget). Runs that go over
+//  budget are counted, and the worst run and the worst lateness of each task are kept for the tools menu.
+//
+//  A lot of DEALR's motion and dealing code still waits on delay(). The Arduino core calls yield() over and
+//  over while it waits inside delay(), so we use that hook to turn every blocking delay into a timed yield:
+//  tasks flagged TASK_RUNS_IN_YIELD (sensing) keep getting serviced during display holds and motor settles.
+//
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "Config.h"
+
+// Task bodies live in the main file.
+void runLogicTask();
+void runMotionTask();
+void runDispensingTask();
+void runDisplayTask();
+void checkButtons();
+void runSensingTask();
+void runPowerTask();
+#if enableConsole
+void runConsoleTask();
+#endif
+#if enableDealerLink && dealerLinkFollower
+void runDealerLinkTask();
+#endif
+
+enum TaskId : uint8_t {
+    TASK_LOGIC,      // Deal-state bookkeeping, IDLE and RESET_DEALR.
+    TASK_MOTION,     // INITIALIZING and ADVANCING: seeks and fine adjusts.
+    TASK_DISPENSING, // DEALING: flywheel and feed servo.
+    TASK_DISPLAY,    // Prompt text while awaiting a decision, and the screensaver timeout.
+    TASK_INPUT,      // Button polling and the actions buttons trigger.
+    TASK_SENSING,    // Card-in-craw polling while a card is being thrown.
+    TASK_POWER,      // Low-power idle decisions (PowerManager.h).
+#if enableConsole
+    TASK_CONSOLE,    // Serial command console (Console.h).
+#endif
+#if enableDealerLink && dealerLinkFollower
+    TASK_LINK,       // The leader's commands on a follower DEALR (DealerLink.h).
+#endif
+    NUM_TASKS,
+    NO_TASK = 0xFF
+};
+
+#define TASK_RUNS_IN_YIELD (1 << 0) // The task is short and safe to run from inside another task's delay().
+
+struct SchedulerTask {
+    void (*run)();
+    uint16_t periodMs; // 0 runs the task on every pass.
+    uint16_t budgetMs; // A single run longer than this counts as an overrun.
+    uint8_t flags;
+    char name[5];
+};
+
+const SchedulerTask schedulerTasks[NUM_TASKS] PROGMEM = {
+    { runLogicTask,      0,  20, 0,                  "LOGC" },
+    { runMotionTask,     0,  30, 0,                  "MOTN" },
+    { runDispensingTask, 0,  50, 0,                  "DEAL" },
+    { runDisplayTask,    10, 15, 0,                  "DSPL" },
+    { checkButtons,      0,  10, 0,                  "INPT" },
+    { runSensingTask,    2,  2,  TASK_RUNS_IN_YIELD, "SENS" },
+    { runPowerTask,      50, 5,  0,                  "POWR" },
+#if enableConsole
+    { runConsoleTask,    20, 10, 0,                  "CONS" },
+#endif
+#if enableDealerLink && dealerLinkFollower
+    { runDealerLinkTask, 20, 10, 0,                  "LINK" },
+#endif
+};
+
+struct TaskStats {
+    uint16_t lastRun;   // Low 16 bits of millis() at the start of the last run.
+    uint16_t worstRun;  // Longest single run, in ms.
+    uint16_t worstLate; // Longest time the task sat past its period before it got to run, in ms.
+    uint16_t overruns;  // Runs that exceeded the task's budget.
+};
+
+TaskStats taskStats[NUM_TASKS];
+uint8_t currentTask = NO_TASK;
+bool schedulerInYield = false;
+
+void runSchedulerTask(uint8_t id, const SchedulerTask& task, uint16_t now) {
+    TaskStats& stats = taskStats[id];
+    uint16_t sinceLast = now - stats.lastRun;
+    if (sinceLast > task.periodMs && sinceLast - task.periodMs > stats.worstLate) {
+        stats.worstLate = sinceLast - task.periodMs;
+    }
+    stats.lastRun = now;
+
+    uint8_t interruptedTask = currentTask;
+    currentTask = id;
+    task.run();
+    currentTask = interruptedTask;
+
+    uint16_t elapsed = (uint16_t)millis() - now;
+    if (elapsed > stats.worstRun) {
+        stats.worstRun = elapsed;
+    }
+    if (elapsed > task.budgetMs) {
+        if (stats.overruns < 0xFFFF) {
+            stats.overruns++;
+        }
+#if enableSerialReports
+        Serial.print(F("OVR "));
+        Serial.print(task.name);
+        Serial.print(' ');
+        Serial.println(elapsed);
+#endif
+    }
+}
+
+// Checks whether a task is due and runs it. Returns false if it wasn't due yet.
+bool serviceTask(uint8_t id) {
+    SchedulerTask task;
+    memcpy_P(&task, &schedulerTasks[id], sizeof(task));
+    uint16_t now = millis();
+    if (task.periodMs != 0 && (uint16_t)(now - taskStats[id].lastRun) < task.periodMs) {
+        return false;
+    }
+    runSchedulerTask(id, task, now);
+    return true;
+}
+
+// One pass over the task table. Called from loop().
+void runScheduler() {
+    for (uint8_t i = 0; i < NUM_TASKS; i++) {
+        serviceTask(i);
+    }
+}
+
+// Called by the Arduino core while it waits in delay(). Runs any yield-safe task that has come due,
+// so a one-second "EXIT" hold no longer leaves the craw sensor unpolled for a whole second.
+void yield() {
+    if (schedulerInYield) {
+        return;
+    }
+    schedulerInYield = true;
+    for (uint8_t i = 0; i < NUM_TASKS; i++) {
+        if (i != currentTask && (pgm_read_byte(&schedulerTasks[i].flags) & TASK_RUNS_IN_YIELD)) {
+            serviceTask(i);
+        }
+    }
+    schedulerInYield = false;
+}
+
+// Diagnostics page: one line per task, e.g. "MOTN 412/30MS LATE 0 OVR 7 ".
+uint8_t schedulerLineCount() {
+    return NUM_TASKS;
+}
+
+void formatSchedulerLine(uint8_t line, char* buffer, size_t size) {
+    char name[5];
+    strncpy_P(name, schedulerTasks[line].name, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    snprintf(buffer, size, "%s %u/%uMS LATE %u OVR %u ", name, taskStats[line].worstRun,
+        pgm_read_word(&schedulerTasks[line].budgetMs), taskStats[line].worstLate, taskStats[line].overruns);
+}
+
+#endif // SCHEDULER_H
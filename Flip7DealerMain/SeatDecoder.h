@@ -0,0 +1,155 @@
+#ifndef SEAT_DECODER_H
+#define SEAT_DECODER_H
+
+//
+//  Works out which seat DEALR is at from the order of the tags, not just from the last tag it read. Once a game has
+//  registered its seats, it knows which tag comes after which, so a step clockwise from seat k should land on k + 1.
+//  Each step is scored the Viterbi way. Every seat keeps the cost of the likeliest way of getting there, which is how
+//  unusual the moves were (passing a tag without reading it, or not getting off one) plus how unlike the reading its
+//  tag's color is. A misread between two colors that are nearly the same (pink and white, or purple and dark blue in
+//  ColorNames.h) then costs less than a skipped tag. The seat the order says wins, so moveToPlayer() doesn't stop
+//  at a neighbour whose tag reads as the player's. It still only stops at a tag that reads as the player's, so a
+//  player who has left isn't dealt at the next tag along.
+//
+//  confidence() is how far a seat is ahead of the next likeliest one. Flip7 steps quickly while the readings agree
+//  with the order, and only takes a longer look at a tag when they don't.
+//
+
+#include <Arduino.h>
+#include "Definitions.h"
+#include "ColorNames.h"
+
+extern RGBColor colors[TOTAL_COLORS];
+
+#define SEAT_UNKNOWN 0xFF
+
+const uint8_t seatSkipCost = 20;        // DEALR passed a tag without reading it.
+const uint8_t seatStayCost = 30;        // DEALR didn't get off the tag it was on.
+const uint8_t seatMisreadMinCost = 2;   // Reading a tag as a color that's nearly the same, like pink for white.
+const uint8_t seatMisreadMaxCost = 60;  // Reading it as a color nothing like it.
+const uint8_t seatMisreadScale = 32;    // Squared distance between the tuned colors for each unit of misread cost.
+const uint8_t seatCostCap = 200;        // Costs stop here, so they fit a byte.
+const uint8_t seatSureMargin = 10;      // A seat this far ahead of the rest doesn't need a second look.
+
+class SeatDecoder {
+  public:
+    // Starts following a ring of seats with these tag colors, clockwise. `at` is the seat DEALR is at, or SEAT_UNKNOWN.
+    // The colors aren't copied, so they have to stay put. Only the first NUM_PLAYER_COLORS seats are followed.
+    void reset(const uint8_t* ringColors, uint8_t seats, uint8_t at) {
+        ring = ringColors;
+        count = seats < NUM_PLAYER_COLORS ? seats : NUM_PLAYER_COLORS;
+        for (uint8_t i = 0; i < count; i++) {
+            cost[i] = (at == SEAT_UNKNOWN || i == at) ? 0 : seatCostCap;
+        }
+    }
+
+    // Stops following, until the next reset(). Until then nothing is decoded and callers go by the readings alone.
+    void clear() {
+        count = 0;
+    }
+
+    bool isActive() const {
+        return count > 0;
+    }
+
+    // DEALR was put down somewhere unknown, after a spin for example, and read this tag.
+    void relocate(uint8_t observed) {
+        reset(ring, count, SEAT_UNKNOWN);
+        observe(observed);
+    }
+
+    // DEALR stepped one tag clockwise and read this one.
+    void step(uint8_t observed) {
+        if (!isActive()) {
+            return;
+        }
+        uint8_t moved[NUM_PLAYER_COLORS];
+        for (uint8_t i = 0; i < count; i++) {
+            uint16_t best = cost[(i + count - 1) % count];                    // from the seat before
+            uint16_t skipped = cost[(i + 2 * count - 2) % count] + seatSkipCost; // from two before, missing one
+            uint16_t stayed = cost[i] + seatStayCost;                         // from here, not having moved
+            if (skipped < best) {
+                best = skipped;
+            }
+            if (stayed < best) {
+                best = stayed;
+            }
+            moved[i] = best < seatCostCap ? best : seatCostCap;
+        }
+        memcpy(cost, moved, count);
+        observe(observed);
+    }
+
+    // DEALR read the tag it's on again, without moving.
+    void recheck(uint8_t observed) {
+        if (isActive()) {
+            observe(observed);
+        }
+    }
+
+    // The likeliest seat.
+    uint8_t seat() const {
+        uint8_t best = 0;
+        for (uint8_t i = 1; i < count; i++) {
+            if (cost[i] < cost[best]) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // How far this seat is ahead of every other one. 0 if it isn't the likeliest, or ties with another seat.
+    uint8_t confidence(uint8_t s) const {
+        uint8_t margin = seatCostCap;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t gap = cost[i] > cost[s] ? cost[i] - cost[s] : 0;
+            if (i != s && gap < margin) {
+                margin = gap;
+            }
+        }
+        return margin;
+    }
+
+    // The color of the tag after the likeliest seat, which the next step should read. 0 when not following a ring.
+    uint8_t nextColor() const {
+        return isActive() ? ring[(seat() + 1) % count] : 0;
+    }
+
+    // The color of the likeliest seat's tag. 0 when not following a ring.
+    uint8_t seatColor() const {
+        return isActive() ? ring[seat()] : 0;
+    }
+
+  private:
+    const uint8_t* ring = nullptr;
+    uint8_t count = 0;
+    uint8_t cost[NUM_PLAYER_COLORS];
+
+    // How unlikely it is to read `observed` at a tag of color `tag`, from how close the two are in the tuned colors.
+    uint8_t misreadCost(uint8_t tag, uint8_t observed) const {
+        if (tag == observed || observed == 0) {
+            return 0;                                   // black says nothing about which tag is near
+        }
+        int16_t dr = colors[tag].r - colors[observed].r;
+        int16_t dg = colors[tag].g - colors[observed].g;
+        int16_t db = colors[tag].b - colors[observed].b;
+        uint32_t distance = ((int32_t)dr * dr + (int32_t)dg * dg + (int32_t)db * db) / seatMisreadScale;
+        return constrain(distance, seatMisreadMinCost, seatMisreadMaxCost);
+    }
+
+    void observe(uint8_t observed) {
+        uint8_t lowest = seatCostCap;
+        for (uint8_t i = 0; i < count; i++) {
+            uint16_t total = cost[i] + misreadCost(ring[i], observed);
+            cost[i] = total < seatCostCap ? total : seatCostCap;
+            if (cost[i] < lowest) {
+                lowest = cost[i];
+            }
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            cost[i] -= lowest;                          // only the differences matter, and this keeps them in range
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+//
+//  Session recording. Adds DEALR's raw inputs to the telemetry stream, so a whole session played at the table can be
+//  replayed through the firmware on a computer (host/dealr_replay). With the state changes and craw edges that
+//  telemetry already sends, a capture holds everything the firmware reacted to:
+//
+//      SENSOR_RG, SENSOR_BC  Every colour sensor sample colorRead() takes, as two frames (red and green, then blue
+//                            and clear).
+//      INPUT                 Every level change on a button that checkButton() sees, and the analogRead() that seeds
+//                            random().
+//      EEPROM                The tuned colours, settings and any saved game as they were at boot, two bytes a frame.
+//
+//  These frames go straight out rather than through logEvent(), so they don't crowd the flight recorder or the
+//  console's counters. While the table turns, the samples take about 2.5 KB/s of the 11.5 KB/s Serial can send.
+//  Needs enableTelemetry. With enableSessionRecording set to false everything here compiles away.
+//
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "Config.h"
+#include "Definitions.h"
+#include "Telemetry.h"
+
+#if enableSessionRecording && enableTelemetry
+
+// The EEPROM bytes a replay needs: the colour table and settings from address 0, then the extras up to the end of
+// the seat ring.
+#define SESSION_EEPROM_END SEAT_RING_END
+
+void recordSensorSample(uint16_t r, uint16_t g, uint16_t b, uint16_t c) {
+    sendEventFrame(EVT_SENSOR_RG, r, g);
+    sendEventFrame(EVT_SENSOR_BC, b, c);
+}
+
+void recordInput(uint8_t pin, uint16_t level) {
+    sendEventFrame(EVT_INPUT, pin, level);
+}
+
+void recordEepromImage() {
+    for (uint16_t addr = 0; addr < SESSION_EEPROM_END; addr += 2) {
+        sendEventFrame(EVT_EEPROM, addr, EEPROM.read(addr) | (EEPROM.read(addr + 1) << 8));
+    }
+}
+
+#else
+inline void recordSensorSample(uint16_t, uint16_t, uint16_t, uint16_t) {}
+inline void recordInput(uint8_t, uint16_t) {}
+inline void recordEepromImage() {}
+#endif // enableSessionRecording && enableTelemetry
+
+#endif // SESSION_RECORDER_H
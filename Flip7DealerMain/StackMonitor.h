@@ -0,0 +1,72 @@
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+//
+//  SRAM headroom monitor. Before anything else runs, the free space between the end of our globals and the top
+//  of the stack is painted with a canary byte. The stack grows down into that space, and whatever it overwrites
+//  stays overwritten. Counting the canaries that are still intact from the bottom up tells us how close the stack
+//  has ever come to the globals (colors[], the Flags structs, ...). If it gets there it corrupts them silently.
+//
+//  stackLowWater() is that all-time minimum, and freeSramNow() is the gap right now. Both are shown on the
+//  diagnostics page and logged whenever an error is reported. Off the AVR (host builds) both report 0.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+
+#define STACK_CANARY 0xC5
+
+#ifdef __AVR__
+extern uint8_t _end;          // End of .data and .bss, i.e. the first byte nothing static lives in.
+extern uint8_t __stack;       // Top of SRAM, where the stack starts.
+extern uint8_t __heap_start;
+extern void* __brkval;        // Top of the heap if malloc() has ever been used, otherwise 0.
+
+// Runs from .init3, before the C runtime sets up globals, so it can't call anything or use the stack.
+void paintStack() __attribute__((naked, used, section(".init3")));
+void paintStack() {
+    for (uint8_t* p = &_end; p < &__stack; p++) {
+        *p = STACK_CANARY;
+    }
+}
+#endif
+
+// Lowest the free space between the heap and the stack has ever been, in bytes.
+uint16_t stackLowWater() {
+#ifdef __AVR__
+    const uint8_t* p = __brkval ? (const uint8_t*)__brkval : &_end; // Anything malloc() took isn't ours to count.
+    uint16_t intact = 0;
+    while (p < &__stack && *p == STACK_CANARY) {
+        p++;
+        intact++;
+    }
+    return intact;
+#else
+    return 0;
+#endif
+}
+
+// Free space between the heap and the stack right now, in bytes.
+uint16_t freeSramNow() {
+#ifdef __AVR__
+    uint8_t top;
+    return &top - (__brkval ? (uint8_t*)__brkval : &__heap_start);
+#else
+    return 0;
+#endif
+}
+
+// Diagnostics page: "FREE 412B ", "LOW 233B ".
+uint8_t stackLineCount() {
+    return 2;
+}
+
+void formatStackLine(uint8_t line, char* buffer, size_t size) {
+    if (line == 0) {
+        snprintf(buffer, size, "FREE %uB ", freeSramNow());
+    } else {
+        snprintf(buffer, size, "LOW %uB ", stackLowWater());
+    }
+}
+
+#endif // STACK_MONITOR_H
@@ -0,0 +1,171 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+//
+//  Binary event telemetry. Each logEvent() call writes one small frame straight to Serial:
+//
+//      [0xA5] [event id] [payload length] [millis(), 4 bytes little-endian] [payload] [checksum]
+//
+//  The checksum is the 8-bit sum of every byte after the 0xA5. Event names and payload formats live in flash
+//  (TELEMETRY_EVENTS below) and are sent once at boot as schema frames, so tools/telemetry_decode.py can turn
+//  the stream back into readable lines without the firmware formatting any text. Nothing is buffered here, so
+//  the only RAM used is the Serial driver's own transmit buffer.
+//
+//  logEvent() is also the one place the rest of the firmware reports events, so anything else that wants to
+//  watch them (the Serial console's counters and the flight recorder, for instance) hooks in there. When nothing is listening, every
+//  logEvent() call compiles away. The host build (host/) always listens, so host programs see the same events.
+//
+//  Format characters follow Python's struct module: B/b = unsigned/signed byte, H/h = unsigned/signed 16-bit
+//  word. An event carries at most two fields, and they are passed to logEvent() as "a" and "b".
+//
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "Config.h"
+
+#define TELEMETRY_SYNC 0xA5
+
+// X(id, name, format): add new events at the end so older logs still decode.
+#define TELEMETRY_EVENTS(X)                                                                                       \
+    X(EVT_BOOT,       "BOOT",       "")   /* Sent once setup() has started Serial.                              */ \
+    X(EVT_DEAL_STATE, "DEAL_STATE", "BB") /* dealState before, dealState after.                                 */ \
+    X(EVT_DISPLAY,    "DISPLAY",    "BB") /* displayState before, displayState after.                           */ \
+    X(EVT_GAME_STATE, "GAME_STATE", "BB") /* The current game's getStateId() before and after.                  */ \
+    X(EVT_ERROR,      "ERROR",      "BB") /* errorCode, dealState at the time.                                  */ \
+    X(EVT_BUTTON,     "BUTTON",     "BB") /* Button pin, 1 for a long press.                                    */ \
+    X(EVT_TAG,        "TAG",        "BB") /* Colour confirmed by fineAdjustCheck(), previous confirmed colour.   */ \
+    X(EVT_CARD,       "CARD",       "BH") /* Colour the card was dealt to, ms from flywheel spin-up to done.    */ \
+    X(EVT_CRAW,       "CRAW",       "B")  /* 1 when a card enters the craw, 0 when it leaves.                   */ \
+    X(EVT_BOOT_PHASE, "BOOT_PHASE", "BH") /* BootPhase, ms it took.                                             */ \
+    X(EVT_STACK,      "STACK",      "HH") /* Free SRAM now, lowest free SRAM since boot (bytes).                 */ \
+    X(EVT_SPAN_BEGIN, "SPAN_BEGIN", "BB") /* TraceSpan starting, its detail byte (see Tracing.h).               */ \
+    X(EVT_SPAN_END,   "SPAN_END",   "BB") /* TraceSpan finished, the same detail byte.                          */ \
+    X(EVT_SENSOR_RG,  "SENSOR_RG",  "HH") /* Raw red and green of a colour sample (SessionRecorder.h).          */ \
+    X(EVT_SENSOR_BC,  "SENSOR_BC",  "HH") /* Raw blue and clear of the same sample.                             */ \
+    X(EVT_INPUT,      "INPUT",      "BH") /* Pin, level read from it (0/1, or 0-1023 for an analog pin).        */ \
+    X(EVT_EEPROM,     "EEPROM",     "HH") /* Address, the two bytes from there (low byte first).                */
+
+#define TELEMETRY_EVENT_ID(id, name, format) id,
+enum TelemetryEvent : uint8_t {
+    EVT_SCHEMA, // Payload: event id, NUL-terminated name, format. One per event, sent at boot.
+    TELEMETRY_EVENTS(TELEMETRY_EVENT_ID)
+    NUM_TELEMETRY_EVENTS
+};
+#undef TELEMETRY_EVENT_ID
+
+// True when anything consumes events. Code that only exists to feed logEvent() can hide behind this.
+#ifdef DEALR_HOST
+#define enableEventLog 1
+#else
+#define enableEventLog (enableTelemetry || enableConsole || enableFlightRecorder)
+#endif
+
+#if enableEventLog
+
+struct TelemetryEventInfo {
+    char name[11];
+    char format[3];
+};
+
+#define TELEMETRY_EVENT_INFO(id, name, format) { name, format },
+const TelemetryEventInfo telemetryEvents[NUM_TELEMETRY_EVENTS] PROGMEM = {
+    { "SCHEMA", "" },
+    TELEMETRY_EVENTS(TELEMETRY_EVENT_INFO)
+};
+#undef TELEMETRY_EVENT_INFO
+
+#if enableFlightRecorder
+void recordFlightEvent(uint8_t id, uint16_t a, uint16_t b); // FlightRecorder.h
+#endif
+
+#ifdef DEALR_HOST
+void hostEvent(uint8_t id, uint16_t a, uint16_t b); // host/HostBoard.cpp
+#endif
+
+#if enableConsole
+uint16_t eventCounts[NUM_TELEMETRY_EVENTS]; // How many times each event has been logged. Read with the console's "c" command.
+#endif
+
+#if enableTelemetry
+// Size in bytes of the payload a format string describes.
+uint8_t telemetryPayloadLength(const char* formatP) {
+    uint8_t length = 0;
+    for (char c = pgm_read_byte(formatP); c != '\0'; c = pgm_read_byte(++formatP)) {
+        length += (c == 'B' || c == 'b') ? 1 : 2;
+    }
+    return length;
+}
+
+void telemetryWrite(uint8_t value, uint8_t& checksum) {
+    Serial.write(value);
+    checksum += value;
+}
+
+void telemetryBeginFrame(uint8_t id, uint8_t length, uint8_t& checksum) {
+    Serial.write(TELEMETRY_SYNC);
+    telemetryWrite(id, checksum);
+    telemetryWrite(length, checksum);
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < 4; i++) {
+        telemetryWrite(now >> (8 * i), checksum);
+    }
+}
+
+void sendEventFrame(uint8_t id, uint16_t a, uint16_t b) {
+    const char* formatP = telemetryEvents[id].format;
+    uint8_t checksum = 0;
+    telemetryBeginFrame(id, telemetryPayloadLength(formatP), checksum);
+    uint16_t field = a;
+    for (char c = pgm_read_byte(formatP); c != '\0'; c = pgm_read_byte(++formatP)) {
+        telemetryWrite(field, checksum);
+        if (c != 'B' && c != 'b') {
+            telemetryWrite(field >> 8, checksum);
+        }
+        field = b;
+    }
+    Serial.write(checksum);
+}
+
+// Describes every event to the host, so the decoder doesn't have to be rebuilt when events are added.
+void sendTelemetrySchema() {
+    for (uint8_t id = 1; id < NUM_TELEMETRY_EVENTS; id++) {
+        const char* nameP = telemetryEvents[id].name;
+        const char* formatP = telemetryEvents[id].format;
+        uint8_t nameLength = strlen_P(nameP);
+        uint8_t formatLength = strlen_P(formatP);
+        uint8_t checksum = 0;
+        telemetryBeginFrame(EVT_SCHEMA, 1 + nameLength + 1 + formatLength, checksum);
+        telemetryWrite(id, checksum);
+        for (uint8_t i = 0; i <= nameLength; i++) {
+            telemetryWrite(pgm_read_byte(nameP + i), checksum);
+        }
+        for (uint8_t i = 0; i < formatLength; i++) {
+            telemetryWrite(pgm_read_byte(formatP + i), checksum);
+        }
+        Serial.write(checksum);
+    }
+}
+#endif // enableTelemetry
+
+void logEvent(uint8_t id, uint16_t a = 0, uint16_t b = 0) {
+#if enableConsole
+    if (eventCounts[id] < 0xFFFF) {
+        eventCounts[id]++;
+    }
+#endif
+#if enableFlightRecorder
+    recordFlightEvent(id, a, b);
+#endif
+#if enableTelemetry
+    sendEventFrame(id, a, b);
+#endif
+#ifdef DEALR_HOST
+    hostEvent(id, a, b);
+#endif
+}
+
+#else
+inline void logEvent(uint8_t, uint16_t = 0, uint16_t = 0) {}
+#endif // enableEventLog
+
+#endif // TELEMETRY_H
@@ -0,0 +1,49 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+//
+//  Span tracing. Drop TRACE_SPAN(span, detail) at the top of a block, and a SPAN_BEGIN telemetry event goes out
+//  when the block starts and a SPAN_END when it exits. tools/trace_to_chrome.py turns a capture into a Chrome
+//  trace timeline (chrome://tracing or ui.perfetto.dev). Deal states and game states come from the DEAL_STATE
+//  and GAME_STATE events that are already sent, so each span only marks blocking work inside them.
+//
+//  Spans travel as ordinary telemetry frames (10 bytes each), so they need enableTelemetry to reach the host.
+//  With enableTracing set to false the macro compiles away to nothing.
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Telemetry.h"
+
+// What each span times. The detail byte sent with it is described next to each one.
+enum TraceSpan : uint8_t {
+    SPAN_CHECK_STATE, // checkState() acting on something: 0 = game over, 1 = error reset.
+    SPAN_GAME_BUTTON, // The current game handling a button press, including any moves and deals it starts. Button pin.
+    SPAN_SEEK,        // A game moving to a player's tag. Target colour.
+    SPAN_STEP,        // One tag forward during a seek, player registration or console "k". Colour it started from.
+    SPAN_SPIN,        // A timed spin with a scrolling message. Duration in tenths of a second.
+    SPAN_FINE_ADJUST, // fineAdjustCheck() creeping onto a tag after a colour spike. Last confirmed colour.
+    SPAN_THROW,       // Dealing from flywheel spin-up until the feed servo is back in place. Cards asked for.
+};
+
+#if enableTracing
+
+struct TraceScope {
+    uint8_t span;
+    uint8_t detail;
+    TraceScope(uint8_t span, uint8_t detail)
+        : span(span), detail(detail) {
+        logEvent(EVT_SPAN_BEGIN, span, detail);
+    }
+    ~TraceScope() {
+        logEvent(EVT_SPAN_END, span, detail);
+    }
+};
+
+#define TRACE_SPAN(span, detail) TraceScope traceScope(span, detail)
+
+#else
+#define TRACE_SPAN(span, detail)
+#endif // enableTracing
+
+#endif // TRACING_H
@@ -0,0 +1,100 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+//
+//  Hardware watchdog. Several waits have no way out if a sensor fails: advancing to a tag that is never seen, for example,
+//  or throwing a card that never gets past the craw. Before, the only fix was a power cycle. Now, if loop() stops coming
+//  round for about 8 seconds, the watchdog interrupt saves the flight recorder (if it's compiled in), marks a fault for
+//  the next boot, and resets DEALR.
+//
+//  The watchdog is fed once per scheduler pass. Blocking code feeds it as it makes progress: a tag reached in a Flip7
+//  move, the steps of a timed spin, a card about to be thrown (those have their own timeout), and each pass of a tools
+//  loop that is waiting for someone to press a button. Rotation that drags on for longer than watchdogMotionLimit
+//  stops feeding it, so a turntable that never finds its tag still gets reset.
+//
+//  Games can save a snapshot at round boundaries (see saveGameSnapshot() in the main file). On the next boot, DEALR goes
+//  straight back to that game's score screen. Hold any button at power-on to start fresh instead.
+//  Turn the watchdog off with watchdogReset in Config.h.
+//
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "Config.h"
+#include "Definitions.h"
+#include "FlightRecorder.h"
+
+#ifdef __AVR__
+#include <avr/wdt.h>
+#include <avr/interrupt.h>
+#endif
+
+#define WATCHDOG_FIRED 0x5EED // Left in watchdogMarker by the interrupt so the next boot knows why it's booting.
+
+extern bool stopped;
+
+const unsigned long watchdogMotionLimit = 10000; // Longest DEALR can keep rotating (in ms) before the main loop stops feeding the watchdog.
+
+unsigned long motionStartedAt = 0; // When the turntable last started moving. Set by rotate().
+
+#ifdef __AVR__
+uint16_t watchdogMarker __attribute__((section(".noinit"))); // Survives the reset, unlike everything the C runtime zeroes.
+
+// Runs from .init3, before the C runtime sets up globals. After a watchdog reset the watchdog stays on, with its shortest
+// timeout, and older Nano bootloaders would keep resetting before setup() had a chance to turn it off.
+void stopWatchdogAtReset() __attribute__((naked, used, section(".init3")));
+void stopWatchdogAtReset() {
+    MCUSR = 0;
+    wdt_disable();
+}
+
+ISR(WDT_vect) {
+#if enableFlightRecorder
+    flushFlightRecorder(FLIGHT_REASON_WATCHDOG);
+#endif
+    EEPROM.update(BOOT_FAULT_ADDR, BOOT_FAULT_SET); // Ask the next boot to run the motor self-check, even with fast boot on.
+    watchdogMarker = WATCHDOG_FIRED;
+    wdt_enable(WDTO_15MS); // Reset straight away instead of waiting out another 8 seconds.
+    while (true) {
+    }
+}
+#endif
+
+// Interrupt-then-reset mode with the longest timeout, so the interrupt can save what it needs before the reset.
+void enableWatchdog() {
+    if (!watchdogReset) {
+        return;
+    }
+#ifdef __AVR__
+    cli();
+    wdt_reset();
+    WDTCSR = bit(WDCE) | bit(WDE);
+    WDTCSR = bit(WDIE) | bit(WDE) | bit(WDP3) | bit(WDP0); // 8 s
+    sei();
+#endif
+}
+
+void feedWatchdog() {
+#ifdef __AVR__
+    wdt_reset();
+#endif
+}
+
+// Called once per scheduler pass. Keeps feeding the watchdog unless the turntable has been rotating for too long.
+void feedWatchdogFromLoop() {
+    if (stopped || millis() - motionStartedAt < watchdogMotionLimit) {
+        feedWatchdog();
+    }
+}
+
+// True once per boot if the last reset came from the watchdog.
+bool watchdogCausedReset() {
+#ifdef __AVR__
+    bool fired = watchdogMarker == WATCHDOG_FIRED;
+    watchdogMarker = 0;
+    return fired;
+#else
+    return false;
+#endif
+}
+
+#endif // WATCHDOG_H
@@ -2,6 +2,8 @@
 #define FLIP7_H
 
 #include "../Game.h"
+#include "../SeatDecoder.h"
+#include "Flip7Length.h"
 
 #define MAX_PLAYERS NUM_PLAYER_COLORS  // max players is number of colors defined in ColorNames.h
 
@@ -10,6 +12,9 @@
 #define IS_ACTIVE (1 << 1) // bit 1
 #define IS_BUST (1 << 2) // bit 2
 #define IS_DEALT (1 << 3) // bit 3
+#if enableDealerLink && !dealerLinkFollower
+#define IS_REMOTE (1 << 4) // bit 4, the seat is one of the other DEALR's (DealerLink.h)
+#endif
 //Helper macros for setting bitmask status
 #define isPlayerPlaying(i) (playerStatus[i] & IS_PLAYING)  // return true if player is playing
 
@@ -28,6 +33,14 @@
 #define setIsNotDealt(i) (playerStatus[i] &= ~IS_DEALT) // set player to not dealt
 #define setAllPlayersNotDealt(MAX_PLAYERS) for (uint8_t i=0; i<MAX_PLAYERS; i++) { if (isPlayerPlaying(i)) setIsNotDealt(i); } // set all players to not dealt
 
+#if enableDealerLink && !dealerLinkFollower
+#define isPlayerRemote(i) (playerStatus[i] & IS_REMOTE)  // return true if the other DEALR deals to this player
+#else
+#define isPlayerRemote(i) false
+#endif
+
+char flip7LengthMessage[22];    // how long a game to ScoretoWin should take, e.g. "300 ~9 RND 25 MIN ".  "990 ~49 RND 275 MIN " is the longest
+
 class Flip7 : public Game {
   public:
 
@@ -60,12 +73,43 @@ class Flip7 : public Game {
         return "FLIP7";
     }
 
+    uint8_t getStateId() const override {
+        return gameState;
+    }
+
+    uint8_t getStartupCapabilities() const override {
+        // no cards are dealt before G, and RegisterPlayers() does its own lap, so DEALR goes straight to the STARTUP prompt
+        return GAME_NO_INITIAL_DEAL | GAME_SELF_REGISTERS;
+    }
+
+    bool isScoring() const override {
+        return gameState == ENTERSCORE;
+    }
+
+    uint8_t getPromptId() const override {
+        // each state asks each player in turn. Y and B at STARTUP, PICKSPECIAL and PICKPLAYER only change the choice
+        return gameState * MAX_PLAYERS + currentPlayerIndex;
+    }
+
+    uint8_t getPlayerCount() const override {
+        return numPlayers;
+    }
+
+    uint8_t getPlayerColor(uint8_t player) const override {
+        return playerColors[player];
+    }
+
+    int16_t getPlayerScore(uint8_t player) const override {
+        return playerScores[player];
+    }
+
     virtual const char** getDisplayMessages(uint8_t &count) {       
         // scrolling messages for each state
         switch (gameState) {
             case STARTUP:
                 static const char* startupMessages[] = { 
                     "G = START ",
+                    flip7LengthMessage,             // shown first after Y/B, so the new total and its length scroll by together
                     "Y/B= TOTAL SCORE "
                 };
                 count = sizeof(startupMessages) / sizeof(startupMessages[0]);
@@ -75,9 +119,13 @@ class Flip7 : public Game {
             case DEALSPECIAL:
                 static const char* dealspecialMessages[] = { 
                     "G = PROCEED ",
-                    "R = SPECIAL "
+                    "R = SPECIAL ",
+                    flip7LengthMessage,             // only in the first round, now the players are counted
                 };
                 count = sizeof(dealspecialMessages) / sizeof(dealspecialMessages[0]);
+                if (!gameFlags.isFirstRound) {
+                    count--;
+                }
                 return dealspecialMessages;
                 break;
 
@@ -132,7 +180,10 @@ class Flip7 : public Game {
                 static const char* reportscoreMessages[] = { 
                     "G = START NEW ROUND ",
                     "Y/B = SHOW SCORES ",
-                    "R = ADJ SCORES "                        
+                    "R = ADJ SCORES ",
+#if enableRoundStats
+                    roundStatsMessage,              // where this round's time went, e.g. "ROT 18% DEAL 9% WAIT 61% SCOR 12% "
+#endif
                 };
                 count = sizeof(reportscoreMessages) / sizeof(reportscoreMessages[0]);
                 return reportscoreMessages;
@@ -151,7 +202,10 @@ class Flip7 : public Game {
                 static const char* gameoverMessages[] = { 
                     "G = NEW GAME ",
                     "R = MAIN MENU ",
-                    "Y/B= SHOW SCORES "                        
+                    "Y/B= SHOW SCORES ",
+#if enableRoundStats
+                    roundStatsMessage,              // the same for the whole game
+#endif
                 };
                 count = sizeof(gameoverMessages) / sizeof(gameoverMessages[0]);
                 return gameoverMessages;
@@ -163,6 +217,7 @@ class Flip7 : public Game {
         // function runs 1st time game starts, sets a bunch of variables/arrays to 0
         setDealAmount(0);
         ScoretoWin = minScore;
+        updateLengthMessage();
         stackPointer = -1;
         numPlayers = 0;
         memset(playerScores, 0, sizeof(playerScores));
@@ -170,6 +225,35 @@ class Flip7 : public Game {
         memset(playerColors, 0, sizeof(playerColors));
         memset(playerStatus, 0, sizeof(playerStatus));
         memset(&gameFlags, 0, sizeof(gameFlags));
+        seats.clear();
+        return true;
+    }
+
+    bool resume() override {
+        // picks the game back up from the last round boundary after a reset, without registering players again
+        Snapshot saved;
+        if (!loadGameSnapshot(&saved, sizeof(saved)) || saved.numPlayers == 0 || saved.numPlayers > MAX_PLAYERS) {
+            return false;
+        }
+        initialize();
+        numPlayers = saved.numPlayers;
+        ScoretoWin = saved.scoreToWin;
+        startPlayerIndex = saved.startPlayerIndex;
+        memcpy(playerColors, saved.playerColors, sizeof(playerColors));
+        memcpy(playerScores, saved.playerScores, sizeof(playerScores));
+        for (uint8_t i = 0; i < numPlayers; i++) {
+            playerStatus[i] = IS_PLAYING;
+#if enableDealerLink && !dealerLinkFollower
+            if (saved.remotePlayers & (1 << i)) {
+                playerStatus[i] |= IS_REMOTE;
+            }
+#endif
+        }
+        currentPlayerIndex = startPlayerIndex;
+        seats.reset(playerColors, countLocalPlayers(), SEAT_UNKNOWN);    // the first step after a reset finds where DEALR is
+        gameState = REPORTSCORE;        // G starts the next round from the next player, as if the round had just been scored
+        resetGameStats();               // times from before the reset were lost with it
+        showRoundStats(false);
         return true;
     }
 
@@ -191,9 +275,7 @@ class Flip7 : public Game {
                     } else {
                         ScoretoWin -= 10;
                     }           
-                    snprintf(displayBuffer, sizeof(displayBuffer), "%d", ScoretoWin);
-                    displayFace(displayBuffer);
-                    gameFlags.isDisplayingSelection = true;
+                    updateLengthMessage();          // scrolls next, starting with the new total
 
                 } else if (button == Buttons::BLUE) {
                     // Increase amount to play to
@@ -202,9 +284,7 @@ class Flip7 : public Game {
                     } else {
                         ScoretoWin += 10;
                     }           
-                    snprintf(displayBuffer, sizeof(displayBuffer), "%d", ScoretoWin);
-                    displayFace(displayBuffer);
-                    gameFlags.isDisplayingSelection = true;
+                    updateLengthMessage();          // scrolls next, starting with the new total
 
                 } else if (button == Buttons::GREEN) {
                     // Accept score and begin game
@@ -213,9 +293,14 @@ class Flip7 : public Game {
                     snprintf(displayBuffer, sizeof(displayBuffer), "%d", ScoretoWin);
                     displayFace(displayBuffer);             //show amount to play to on screen briefly
                     gameFlags.isDisplayingSelection = true;
-                    delay(500);
+                    resetGameStats();       // the game's time starts here, registration included
+                    pacedDelay(500);
                     RegisterPlayers(); // register each player
+                    expectedPlayers = numPlayers;
+                    updateLengthMessage();  // the estimate for the players actually here, shown while dealing the first round
+                    gameFlags.isFirstRound = true;
                     setPlayersActiveIfPlaying(MAX_PLAYERS); // set all players who are playing as active
+                    saveSnapshot();         // players are known, so a reset from here on won't need them registered again
                     dealOne(); //deal to starting player
                     gameFlags.isDisplayingSelection = false;
                 }
@@ -241,7 +326,7 @@ class Flip7 : public Game {
             case ACTION:            //  player chooses to hit (draw card) or to stand
                 if (button == Buttons::RED) {
                     // draw one immediately and move to PICK state to resolve card
-                    dispenseCards(1);
+                    dealToCurrentPlayer(1);
                     gameState = PICK;
 
                 } else if (button == Buttons::YELLOW) {
@@ -423,7 +508,7 @@ class Flip7 : public Game {
                                 returnPlayerStack[stackPointer] = currentPlayerIndex;  
                             }                    
                             moveToPlayer(displayedPlayerIndex);         //move to selected player
-                            dispenseCards(3);                           //deal 3 cards
+                            dealToCurrentPlayer(3);                     //deal 3 cards
                             gameState = PICK;                           //pick screen
                         }
                     }
@@ -457,6 +542,7 @@ class Flip7 : public Game {
                         if (!moveToNextunBustedPlayer((startPlayerIndex - 1 + numPlayers)%numPlayers)) {  // move to 1st unbusted player
                             gameState = REPORTSCORE;            // If no unbusted players found, everyone busted and no scores to enter. Move to reportscore
                             gameFlags.isAdjScore = false;
+                            showRoundStats(false);
                             break;
                         }
                         gameFlags.isDisplayingSelection = true;
@@ -471,6 +557,7 @@ class Flip7 : public Game {
                             gameState = REPORTSCORE;
                             tallyScores();                          //add current round scores to total scores
                             uint8_t winner = checkForWinner();      // check for winner
+                            showRoundStats(winner != 255);          // round time on the score screen, game time on game over
                             if (winner != 255){                     // if winner end game, otherwise move to REPORTSCORE
                                 char winnerMessage[9];
                                 const char* colorName = getColorName(playerColors[winner]);
@@ -478,7 +565,10 @@ class Flip7 : public Game {
                                 spin(winnerMessage, spin_win);          //display winner's color and spin
                                 moveToPlayer(winner);
                                 gameState = GAMEOVER;
-                            } 
+                                clearGameSnapshot();                // nothing to resume once the game is won
+                            } else {
+                                saveSnapshot();                     // round boundary, save scores in case of a reset
+                            }
                         }
                     }
                 }
@@ -505,6 +595,8 @@ class Flip7 : public Game {
                     setPlayersActiveIfPlaying(MAX_PLAYERS)          //reset active
                     setAllPlayersNotDealt(MAX_PLAYERS)              //reset dealt
                     stackPointer = -1;
+                    resetRoundStats();
+                    gameFlags.isFirstRound = false;
                     startPlayerIndex = (startPlayerIndex +1) % numPlayers;       //increment starting player by one
                     moveToPlayer(startPlayerIndex);
                     gameFlags.isDealing = true;
@@ -598,11 +690,14 @@ class Flip7 : public Game {
 
 
   private:
+    friend struct Flip7Inspector;  // Flip7Inspector.h sets up players and states directly, and reads them back
     uint8_t numPlayers = 0;  // number of players in the game
     const uint16_t minScore = 200; // Min score allowed
     uint16_t ScoretoWin = minScore; // Default score to play to - adjust this in startup screen
     const uint16_t maxScore = 990; // Max score allowed
     const int16_t maxRoundScore = 171;  //maximum that can be achieved in 1 round
+    uint8_t expectedPlayers = 4;        // players in the last game registered, for the length estimate before this one's are
+    const uint8_t seatRingChecks = 3;   // tags checked against the saved seat ring at the start of a game, instead of a full lap
     char displayBuffer[5];
     struct {
         uint8_t isDisplayingSelection : 1;      //true if overriding scrolling message
@@ -611,6 +706,7 @@ class Flip7 : public Game {
         uint8_t isDealing : 1;                  //true when machine is performing initial deal of one card to everyone
         uint8_t isAdjScore : 1;                 //true when in adjust score mode
         uint8_t adjSign : 1;                    //false is positive and true is negative
+        uint8_t isFirstRound : 1;               //true from registration until the second round starts
     } gameFlags;
 
     GameState gameState = STARTUP; // game starts in startup state
@@ -629,6 +725,20 @@ class Flip7 : public Game {
     static const uint8_t MAX_FLIP3_DEPTH = 4;       //maximum amount of flip3 that can occur in a row
     uint8_t returnPlayerStack[MAX_FLIP3_DEPTH];  // stack for returning to playerindex after flip3
     int8_t stackPointer = -1;                       // tracks indexes in returnPlayerStack,  -1 for empty
+    SeatDecoder seats;                              // which of this DEALR's players it's at, from the order of the tags it reads
+
+    // what's saved to EEPROM at each round boundary so the game can be resumed after a reset
+    struct Snapshot {
+        uint8_t numPlayers;
+        uint16_t scoreToWin;
+        uint8_t startPlayerIndex;
+        uint8_t playerColors[MAX_PLAYERS];
+        int16_t playerScores[MAX_PLAYERS];
+#if enableDealerLink && !dealerLinkFollower
+        uint8_t remotePlayers;      // bit i set if the other DEALR deals to player i
+#endif
+    };
+    static_assert(sizeof(Snapshot) <= GAME_SNAPSHOT_MAX_DATA, "Flip7's snapshot doesn't fit in the EEPROM snapshot area");
 
     //spin durations
     const uint16_t spin_normal = 4000;      //ms
@@ -670,6 +780,7 @@ class Flip7 : public Game {
 
     void advanceOnePosition() {
         // moves machine forward one tag position
+        TRACE_SPAN(SPAN_STEP, activeColor);
         moveOffActiveColor(CW);   //get started by moving into black
         rotate(mediumSpeed, CW);    //rotate at medium speed to ensure reading of colors
         while (activeColor == 0) {       //keep rotating until the active color is not black
@@ -685,8 +796,19 @@ class Flip7 : public Game {
         }
         delay(10);  //all tags rotate a little longer to get to center of tag to avoid edge readings
         rotateStop();
+        uint8_t expectedColor = seats.nextColor();
         for (uint8_t i = 0; i<15; i++) {
             colorScan();                    //after stopping, perform color scan multiple times to get a stable color
+            if (expectedColor != 0 && i + 1 >= debounceCount && activeColor == expectedColor) {
+                break;                      //the tag the seat order says comes next, so it's not an edge reading
+            }
+        }
+        seats.step(activeColor);
+        if (seats.isActive() && (activeColor != seats.seatColor() || seats.confidence(seats.seat()) < seatSureMargin)) {
+            for (uint8_t i = 0; i<15; i++) {
+                colorScan();                //the reading and the seat order disagree, so take a longer look
+            }
+            seats.recheck(activeColor);
         }
     }
 
@@ -696,24 +818,97 @@ class Flip7 : public Game {
         for (uint8_t i = 0; i<15; i++) {
             colorScan();            //at the start, perform color scan to get a stable color for first tag
         }
-        uint8_t startingColor = activeColor;
+        if (activeColor == 0) {
+            advanceOnePosition();   //DEALR doesn't turn to red before Flip7, so it may have stopped between tags
+        }
         startPlayerIndex = 0;
-        do {
-            if (numPlayers < MAX_PLAYERS) {
-                playerColors[numPlayers] = activeColor;     // Store the color of the player
-                playerScores[numPlayers] = 0;               // Initialize player score to 0
-                playerStatus[numPlayers] = IS_PLAYING;      // Set player as playing
-                numPlayers++;
-            }
-            gameFlags.isDisplayingSelection = true;
-            displayFace(getColorName(playerColors[numPlayers - 1]));    //display players color for confirmation
-            delay(400);
-            advanceOnePosition(); // Move to the next position
-        } while (activeColor != startingColor);         //keep advancing until start color is seen again
+        if (!checkSavedSeats()) {                       //same table as last time? Then there's no need for a lap
+            uint8_t startingColor = activeColor;
+            do {
+                if (numPlayers < MAX_PLAYERS) {
+                    playerColors[numPlayers] = activeColor;     // Store the color of the player
+                    playerScores[numPlayers] = 0;               // Initialize player score to 0
+                    playerStatus[numPlayers] = IS_PLAYING;      // Set player as playing
+                    numPlayers++;
+                }
+                gameFlags.isDisplayingSelection = true;
+                displayFace(getColorName(playerColors[numPlayers - 1]));    //display players color for confirmation
+                pacedDelay(400);
+                if (numPlayers < MAX_PLAYERS) {
+                    feedWatchdog();     // still finding new players. If the start tag is never seen again, the watchdog resets DEALR
+                }
+                advanceOnePosition(); // Move to the next position
+            } while (activeColor != startingColor);         //keep advancing until start color is seen again
+            saveSeatRing(playerColors, numPlayers);         //so the next game can check a few tags instead
+        }
+#if enableDealerLink && !dealerLinkFollower
+        if (numPlayers < MAX_PLAYERS && linkHello()) {
+            RegisterRemotePlayers();                    // the other DEALR's seats come after this one's
+        }
+#endif
+        seats.reset(playerColors, countLocalPlayers(), 0);     //DEALR is back at player 0
         currentPlayerIndex = 0;
         gameFlags.isDisplayingSelection = false;
     }    
 
+    bool checkSavedSeats() {
+        // checks the next few tags against the ones the last full lap found. If they follow on in the same order, those
+        // players are registered without a lap, with the last tag checked as player 0. Returns false to do the lap instead
+        uint8_t savedColors[MAX_PLAYERS];
+        uint8_t count = loadSeatRing(savedColors, MAX_PLAYERS);
+        uint8_t seat = 0;
+        while (seat < count && savedColors[seat] != activeColor) {
+            seat++;
+        }
+        if (seat == count) {
+            return false;                               //no saved ring, or this tag isn't in it
+        }
+        uint8_t checks = count < seatRingChecks ? count + 1 : seatRingChecks;  //with 1 or 2 players, that's back round to the first tag
+        gameFlags.isDisplayingSelection = true;
+        for (uint8_t i = 1; i < checks; i++) {
+            displayFace(getColorName(activeColor));    //display players color for confirmation
+            pacedDelay(400);
+            feedWatchdog();
+            advanceOnePosition();
+            seat = (seat + 1) % count;
+            if (activeColor != savedColors[seat]) {
+                return false;                           //something moved. The lap starts from here
+            }
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            playerColors[i] = savedColors[(seat + i) % count];
+            playerScores[i] = 0;
+            playerStatus[i] = IS_PLAYING;
+        }
+        numPlayers = count;
+        displayFace(getColorName(activeColor));
+        pacedDelay(400);
+        return true;
+    }
+
+#if enableDealerLink && !dealerLinkFollower
+    void RegisterRemotePlayers() {
+        // has the other DEALR do its lap, and seats its players after ours
+        uint8_t colors[MAX_PLAYERS];
+        uint8_t found = linkRegister(colors, MAX_PLAYERS - numPlayers);
+        for (uint8_t i = 0; i < found; i++) {
+            bool seated = false;
+            for (uint8_t j = 0; j < numPlayers; j++) {
+                seated |= playerColors[j] == colors[i];
+            }
+            if (seated || colors[i] == 0) {
+                continue;                               // a tag the same color as one here couldn't be told apart, so it's left out
+            }
+            playerColors[numPlayers] = colors[i];
+            playerScores[numPlayers] = 0;
+            playerStatus[numPlayers] = IS_PLAYING | IS_REMOTE;
+            numPlayers++;
+            displayFace(getColorName(colors[i]));       //display players color for confirmation
+            pacedDelay(400);
+        }
+    }
+#endif
+
     bool areActivePlayers() const {
         // returns true if there are any active players remaining
         for (uint8_t i = 0; i<numPlayers; i++) {
@@ -782,23 +977,71 @@ class Flip7 : public Game {
             return false;
         }
         uint8_t targetColor = playerColors[targetPlayerIndex];
+        TRACE_SPAN(SPAN_SEEK, targetColor);
 
-        if (activeColor == targetColor){            //check to see if already at desired player
+#if enableDealerLink && !dealerLinkFollower
+        if (isPlayerRemote(targetPlayerIndex)) {
+            linkSeek(targetColor);                  //the other DEALR turns while the player decides. This one stays where it is
+            currentPlayerIndex = targetPlayerIndex;
+            return true;
+        }
+#endif
+        if (isAtPlayer(targetPlayerIndex, 0)){      //check to see if already at desired player
             currentPlayerIndex = targetPlayerIndex;
             return true;
         }
 
-        while (activeColor != targetColor) {        //keep advancing one position until target player found
+        uint8_t steps = 0;
+        while (!isAtPlayer(targetPlayerIndex, steps)) {     //keep advancing one position until target player found
+            if (steps++ == 2 * numPlayers) {
+                leaveForMissingSeat();              //two laps and the tag never came round, so the player isn't there
+                return false;
+            }
+            feedWatchdog();
             advanceOnePosition();
         }
         currentPlayerIndex = targetPlayerIndex; // Update the current player index
         return true;
     }
 
+    void leaveForMissingSeat() {
+        // a player's tag is gone. The saved ring and game both still have it, so forget them, or the next boot would
+        // resume into the same seek. The next game registers with a full lap
+        clearSeatRing();
+        clearGameSnapshot();
+        reportError(ERR_SEAT_GONE);
+        gameFlags.isDisplayingSelection = false;
+        flags4.gamesExit = true;
+        displayErrorMessage("EROR SEAT GONE");         //sets RESET_DEALR, which leaves to the game menu
+    }
+
+    bool isAtPlayer(uint8_t playerIndex, uint8_t steps) const {
+        // the tag under the sensor has to be the player's. The seat order can only overrule it the other way, when a
+        // neighbour's tag reads as the player's. Never stopping at a different color means a player whose tag is gone
+        // isn't dealt at the next tag. After a lap without finding the player, the tags must have moved, so only the
+        // reading counts
+        if (activeColor != playerColors[playerIndex]) {
+            return false;
+        }
+        if (seats.isActive() && steps <= numPlayers && seats.confidence(seats.seat()) > 0) {
+            return seats.seat() == playerIndex;
+        }
+        return true;
+    }
+
+    uint8_t countLocalPlayers() const {
+        // players at this DEALR's own tags. They come first, before any the other DEALR registered
+        uint8_t count = 0;
+        while (count < numPlayers && !isPlayerRemote(count)) {
+            count++;
+        }
+        return count;
+    }
+
     void spin(const char* message, uint16_t spinDuration) {
         // spin machine the desired time while scrolling message
         gameFlags.isSpinning = true;
-        startScrollText(message, textStartHoldTime, textSpeedInterval, textEndHoldTime);  //Start the scrolling text using variables from Config.h
+        startScrollText(message, paced(textStartHoldTime), paced(textSpeedInterval), paced(textEndHoldTime));  //Start the scrolling text using variables from Config.h, paced for the table
 
         if (spinDuration == 0){
             stopScrollText();
@@ -806,15 +1049,21 @@ class Flip7 : public Game {
             return;
         }
 
+        TRACE_SPAN(SPAN_SPIN, spinDuration / 100);
         rotate(highSpeed, CW);              //spin at high speed
         unsigned long startTime = millis();
 
         while (millis() - startTime < spinDuration) {
+            feedWatchdog();                 //the win spin is as long as the watchdog timeout, but it always ends
             updateScrollText();
             delay(1);
         }
         rotateStop();
         delay(50);
+        for (uint8_t i = 0; i<15; i++) {
+            colorScan();                    //read the tag the spin stopped on, or black, so moveToPlayer() doesn't go by the color from before the spin
+        }
+        seats.relocate(activeColor);        //the spin could have stopped anywhere
 
         stopScrollText();
         gameFlags.isSpinning = false;
@@ -841,6 +1090,18 @@ class Flip7 : public Game {
         return false;
     }
 
+    void updateLengthMessage() {
+        // fills flip7LengthMessage from the simulated game lengths in Flip7Length.h, for expectedPlayers playing to ScoretoWin
+        uint8_t row = constrain(expectedPlayers, FLIP7_LENGTH_FEWEST_PLAYERS, FLIP7_LENGTH_FEWEST_PLAYERS + FLIP7_LENGTH_PLAYER_COUNTS - 1) - FLIP7_LENGTH_FEWEST_PLAYERS;
+        uint16_t above = ScoretoWin - FLIP7_LENGTH_FIRST_TARGET;
+        uint8_t column = constrain(above / FLIP7_LENGTH_TARGET_STEP, 0, FLIP7_LENGTH_TARGETS - 2);
+        uint16_t low = pgm_read_word(&flip7LengthRounds[row][column]);
+        uint16_t high = pgm_read_word(&flip7LengthRounds[row][column + 1]);
+        uint16_t tenths = low + (uint32_t)(high - low) * (above - column * FLIP7_LENGTH_TARGET_STEP) / FLIP7_LENGTH_TARGET_STEP;  // in between, the rounds grow in a straight line
+        uint16_t minutes = ((uint32_t)tenths * pgm_read_word(&flip7LengthRoundSeconds[row]) + 300) / 600;
+        snprintf(flip7LengthMessage, sizeof(flip7LengthMessage), "%u ~%u RND %u MIN ", ScoretoWin, (tenths + 5) / 10, minutes);
+    }
+
     void displayPlayerScore(uint8_t playerIndex) {
         //displays the score playerIndex
         int16_t score = currentRoundScores[playerIndex];
@@ -932,13 +1193,47 @@ class Flip7 : public Game {
         return winnerIndex;
     }
 
+    void saveSnapshot() const {
+        // save the scores and players at a round boundary
+        Snapshot snapshot;
+        snapshot.numPlayers = numPlayers;
+        snapshot.scoreToWin = ScoretoWin;
+        snapshot.startPlayerIndex = startPlayerIndex;
+        memcpy(snapshot.playerColors, playerColors, sizeof(playerColors));
+        memcpy(snapshot.playerScores, playerScores, sizeof(playerScores));
+#if enableDealerLink && !dealerLinkFollower
+        snapshot.remotePlayers = 0;
+        for (uint8_t i = 0; i < numPlayers; i++) {
+            if (isPlayerRemote(i)) {
+                snapshot.remotePlayers |= 1 << i;
+            }
+        }
+#endif
+        saveGameSnapshot(&snapshot, sizeof(snapshot));
+    }
+
     void dealOne() {
         // deal one card to current player and set status to isdealt
-        dispenseCards(1);
-        delay(500);
+        dealToCurrentPlayer(1);
+        pacedDelay(500);
         setIsPlayerDealt(currentPlayerIndex);
     }
 
+    void dealToCurrentPlayer(uint8_t amount) {
+        // deals from this DEALR, or has the other one deal if the current player is one of its seats
+        if (currentDealState == RESET_DEALR) {
+            return;                                     //the seek to this player gave up, and the game is leaving
+        }
+#if enableDealerLink && !dealerLinkFollower
+        if (isPlayerRemote(currentPlayerIndex)) {
+            feedWatchdog();                             // the link has its own timeouts, and feeds the watchdog while it waits
+            linkDeal(playerColors[currentPlayerIndex], amount);
+            return;
+        }
+#endif
+        dispenseCards(amount);
+    }
+
     void proceedDealing() {
         //checks to see if there are active and undealt players, if so advances to next one and deals a card
         // if no active and undealt, move to ACTION state
@@ -0,0 +1,75 @@
+#ifndef FLIP7_INSPECTOR_H
+#define FLIP7_INSPECTOR_H
+
+#include "Flip7.h"
+
+// Sets up, drives and reads a Flip7 game without going through the turntable. A friend of Flip7, for Bench.h and the
+// host's state-space explorer (host/flip7_paths.cpp).
+struct Flip7Inspector {
+    // Longest stateKey(): the fixed fields, a status for each player and a return player for each Flip Three.
+    static const uint8_t KEY_SIZE = 9 + MAX_PLAYERS + Flip7::MAX_FLIP3_DEPTH;
+
+    static void seatPlayers(Flip7& game, uint8_t count) {
+        game.initialize();
+        game.numPlayers = count;
+        for (uint8_t i = 0; i < count; i++) {
+            game.playerColors[i] = i + 1;
+            game.playerStatus[i] = IS_PLAYING;
+        }
+    }
+    static void setState(Flip7& game, uint8_t state) {
+        game.gameState = (Flip7::GameState)state;
+        game.gameFlags.isDisplayingSelection = true; // Score entry and player picking act on the shown player.
+    }
+    static void cycleOnesDigit(Flip7& game, uint8_t player) {
+        game.cycleOnesDigit(player);
+    }
+
+    // The score screen at the end of a round, with DEALR at player `at`. G from here deals a round starting at `first`.
+    static void endRound(Flip7& game, uint8_t first, uint8_t at) {
+        game.gameState = Flip7::REPORTSCORE;
+        game.gameFlags.isDisplayingSelection = false;
+        game.startPlayerIndex = (first + game.numPlayers - 1) % game.numPlayers;   // G moves it on one
+        game.currentPlayerIndex = at;
+        game.seats.reset(game.playerColors, game.numPlayers, at);
+    }
+
+    static uint8_t state(const Flip7& game) { return game.gameState; }
+    static uint8_t currentPlayer(const Flip7& game) { return game.currentPlayerIndex; }
+    static uint8_t playerColor(const Flip7& game, uint8_t player) { return game.playerColors[player]; }
+    static uint8_t flip3Depth(const Flip7& game) { return game.stackPointer + 1; }
+    static bool isShowingPlayer(const Flip7& game) { return game.gameFlags.isDisplayingSelection; }
+    static uint8_t specialCard(const Flip7& game) { return game.specialState; }
+
+    // Everything that decides what the next press does, apart from the scores, which only the score screens read.
+    // Two games with the same key act the same from here on. Returns the key's length.
+    // Fields are left out (as 0) where nothing reads them before they're set again: the special card and the state to
+    // go back to outside PICKSPECIAL and PICKPLAYER, the player on show outside PICKPLAYER, and who's been dealt once
+    // the opening deal is over. The seat decoder's costs are left out too: while every tag reads true, it always
+    // decodes the seat DEALR is at, whatever the costs.
+    static uint8_t stateKey(const Flip7& game, uint8_t* key) {
+        bool picking = game.gameState == Flip7::PICKSPECIAL || game.gameState == Flip7::PICKPLAYER;
+        uint8_t statusMask = game.gameFlags.isDealing ? 0xFF : (uint8_t)~IS_DEALT;
+        uint8_t length = 0;
+        key[length++] = game.gameState;
+        key[length++] = picking ? game.specialState : 0;
+        key[length++] = picking ? game.prevState : 0;
+        key[length++] = game.numPlayers;
+        key[length++] = game.currentPlayerIndex;
+        key[length++] = game.startPlayerIndex;
+        key[length++] = game.gameState == Flip7::PICKPLAYER ? game.displayedPlayerIndex : 0;
+        key[length++] = game.stackPointer;
+        key[length++] = game.gameFlags.isDisplayingSelection | game.gameFlags.isShowingScore << 1 |
+                        game.gameFlags.isSpinning << 2 | game.gameFlags.isDealing << 3 | game.gameFlags.isAdjScore << 4 |
+                        game.gameFlags.adjSign << 5 | game.gameFlags.isFirstRound << 6;
+        for (uint8_t i = 0; i < game.numPlayers; i++) {
+            key[length++] = game.playerStatus[i] & statusMask;
+        }
+        for (int8_t i = 0; i <= game.stackPointer; i++) {
+            key[length++] = game.returnPlayerStack[i];
+        }
+        return length;
+    }
+};
+
+#endif
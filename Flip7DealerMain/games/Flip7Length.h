@@ -0,0 +1,31 @@
+#ifndef FLIP7_LENGTH_H
+#define FLIP7_LENGTH_H
+
+//
+//  How long a game of Flip7 lasts, for the estimate on the STARTUP screen. Generated by host/dealr_flip7_odds
+//  --progmem from 20000 simulated games per player count (table: steady, seed 1). Rerun it rather than editing this.
+//
+
+#include <Arduino.h>
+
+#define FLIP7_LENGTH_FEWEST_PLAYERS 2
+#define FLIP7_LENGTH_PLAYER_COUNTS 7
+#define FLIP7_LENGTH_FIRST_TARGET 200
+#define FLIP7_LENGTH_TARGET_STEP 100
+#define FLIP7_LENGTH_TARGETS 9
+
+// Rounds until someone reaches each target, in tenths, by player count.
+const uint16_t flip7LengthRounds[FLIP7_LENGTH_PLAYER_COUNTS][FLIP7_LENGTH_TARGETS] PROGMEM = {
+    { 98, 147, 196, 246, 296, 346, 396, 446, 497 }, // 2 players
+    { 93, 142, 191, 241, 291, 341, 392, 442, 493 }, // 3 players
+    { 91, 139, 189, 239, 289, 340, 391, 442, 493 }, // 4 players
+    { 89, 138, 187, 238, 288, 339, 390, 442, 493 }, // 5 players
+    { 88, 137, 187, 237, 288, 339, 390, 442, 493 }, // 6 players
+    { 88, 137, 186, 237, 288, 339, 391, 443, 495 }, // 7 players
+    { 87, 136, 186, 236, 287, 338, 390, 442, 494 }, // 8 players
+};
+
+// Seconds per round at the table, by player count.
+const uint16_t flip7LengthRoundSeconds[FLIP7_LENGTH_PLAYER_COUNTS] PROGMEM = { 83, 125, 168, 210, 253, 295, 338 };
+
+#endif // FLIP7_LENGTH_H
@@ -0,0 +1,31 @@
+// Read-only view of the firmware's state for host programs, which can't include the firmware headers themselves
+// (they define globals). Implemented at the end of firmware.cpp, inside the firmware's translation unit.
+#ifndef FIRMWARE_PROBE_H
+#define FIRMWARE_PROBE_H
+
+#include <stdint.h>
+
+namespace FirmwareProbe {
+
+uint8_t dealState();           // currentDealState, as the dealState enum in Enums.h.
+bool awaitingDecision();       // True while a game prompt waits for a button (AWAITING_PLAYER_DECISION).
+int gameState();               // The running game's getStateId(), or -1 outside a game.
+uint8_t activeColor();         // The tag colour DEALR last settled on. 0 is black (no tag).
+bool errorShowing();           // An error is on the display or being recovered from.
+int eventId(const char* name); // The id HostBoard::onEvent gets for an event named in Telemetry.h, or -1.
+uint8_t playerCount();         // The running game's players, 0 outside a game.
+uint8_t playerColor(uint8_t player);
+int16_t playerScore(uint8_t player);
+
+// The sketch's tag-sensing constants, for tools that model them. integrationTime() is what setup() gave the sensor.
+uint8_t integrationTime();
+uint8_t debounceCount();
+float spikeThreshold(); // Times the black baseline in checkForColorSpike().
+uint8_t highSpeed();
+uint8_t mediumSpeed();
+uint8_t lowSpeed();
+uint8_t numSamples();
+
+}
+
+#endif // FIRMWARE_PROBE_H
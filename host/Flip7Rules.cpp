@@ -0,0 +1,362 @@
+#include "Flip7Rules.h"
+
+#include <algorithm>
+
+namespace {
+const int plusCards[] = { 2, 4, 6, 8, 10 };
+const int actionCopies = 3;
+const int flip7Numbers = 7;
+const int flipThreeCards = 3;
+}
+
+Flip7Deck::Flip7Deck() {
+    all.push_back({ Flip7CardKind::Number, 0 });
+    for (int value = 1; value <= highestNumber; value++) {
+        for (int copy = 0; copy < value; copy++) {
+            all.push_back({ Flip7CardKind::Number, static_cast<uint8_t>(value) });
+        }
+    }
+    for (int plus : plusCards) {
+        all.push_back({ Flip7CardKind::Plus, static_cast<uint8_t>(plus) });
+    }
+    all.push_back({ Flip7CardKind::TimesTwo, 0 });
+    for (int copy = 0; copy < actionCopies; copy++) {
+        all.push_back({ Flip7CardKind::Freeze, 0 });
+        all.push_back({ Flip7CardKind::FlipThree, 0 });
+        all.push_back({ Flip7CardKind::SecondChance, 0 });
+    }
+    std::fill(inPile, inPile + highestNumber + 1, 0);
+    std::fill(inDiscards, inDiscards + highestNumber + 1, 0);
+}
+
+void Flip7Deck::reset(std::mt19937& rng) {
+    pile = all;
+    discards.clear();
+    std::fill(inDiscards, inDiscards + highestNumber + 1, 0);
+    std::fill(inPile, inPile + highestNumber + 1, 0);
+    for (const Flip7Card& card : pile) {
+        if (card.kind == Flip7CardKind::Number) {
+            inPile[card.value]++;
+        }
+    }
+    std::shuffle(pile.begin(), pile.end(), rng);
+}
+
+bool Flip7Deck::draw(std::mt19937& rng, Flip7Card& card) {
+    if (pile.empty()) {
+        if (discards.empty()) {
+            return false;
+        }
+        pile.swap(discards);
+        std::copy(inDiscards, inDiscards + highestNumber + 1, inPile);
+        std::fill(inDiscards, inDiscards + highestNumber + 1, 0);
+        std::shuffle(pile.begin(), pile.end(), rng);
+    }
+    card = pile.back();
+    pile.pop_back();
+    if (card.kind == Flip7CardKind::Number) {
+        inPile[card.value]--;
+    }
+    return true;
+}
+
+void Flip7Deck::discard(const Flip7Card& card) {
+    discards.push_back(card);
+    if (card.kind == Flip7CardKind::Number) {
+        inDiscards[card.value]++;
+    }
+}
+
+double Flip7Deck::chanceOfNumber(uint16_t numbers) const {
+    const int* counts = pile.empty() ? inDiscards : inPile;
+    size_t size = pile.empty() ? discards.size() : pile.size();
+    if (size == 0) {
+        return 0;
+    }
+    int matching = 0;
+    for (int value = 0; value <= highestNumber; value++) {
+        if (numbers & (1 << value)) {
+            matching += counts[value];
+        }
+    }
+    return static_cast<double>(matching) / size;
+}
+
+int Flip7Deck::maxRoundScore() const {
+    std::vector<int> numbers;
+    int plus = 0;
+    bool timesTwo = false;
+    for (const Flip7Card& card : all) {
+        if (card.kind == Flip7CardKind::Number && std::find(numbers.begin(), numbers.end(), card.value) == numbers.end()) {
+            numbers.push_back(card.value);
+        } else if (card.kind == Flip7CardKind::Plus) {
+            plus += card.value;
+        } else if (card.kind == Flip7CardKind::TimesTwo) {
+            timesTwo = true;
+        }
+    }
+    std::sort(numbers.rbegin(), numbers.rend());
+    int sum = 0;
+    for (int i = 0; i < flip7Numbers && i < static_cast<int>(numbers.size()); i++) {
+        sum += numbers[i];
+    }
+    return (timesTwo ? 2 * sum : sum) + plus + flip7Bonus;
+}
+
+const std::vector<Flip7Strategy>& flip7Strategies() {
+    static const std::vector<Flip7Strategy> strategies = {
+        { "cautious", 15, 1.0, 10 },
+        { "steady", 25, 1.0, 20 },
+        { "bold", 35, 1.0, 30 },
+        { "counter", 0, 0.3, 20 }, // Counts the cards out and stays when the next one is a 30% bust.
+        { "reckless", 0, 1.0, 1000 }, // Only a bust, a Freeze or a Flip 7 stops it.
+    };
+    return strategies;
+}
+
+const Flip7Strategy* findFlip7Strategy(const std::string& name) {
+    for (const Flip7Strategy& strategy : flip7Strategies()) {
+        if (name == strategy.name) {
+            return &strategy;
+        }
+    }
+    return nullptr;
+}
+
+int Flip7Table::Hand::score() const {
+    if (busted) {
+        return 0;
+    }
+    return (timesTwo ? 2 * sum : sum) + plus + (count == flip7Numbers ? Flip7Deck::flip7Bonus : 0);
+}
+
+Flip7Table::Flip7Table(const std::vector<const Flip7Strategy*>& seats, uint32_t seed)
+    : seats(seats), scores(seats.size(), 0), rng(seed) {
+    deck.reset(rng);
+}
+
+int Flip7Table::winner(int target) const {
+    // checkForWinner(): the highest score at or over the target, the first seat on a tie.
+    int winnerSeat = -1;
+    int highest = 0;
+    for (size_t i = 0; i < scores.size(); i++) {
+        if (scores[i] >= target && scores[i] > highest) {
+            highest = scores[i];
+            winnerSeat = static_cast<int>(i);
+        }
+    }
+    return winnerSeat;
+}
+
+Flip7Round Flip7Table::playRound() {
+    const int n = static_cast<int>(seats.size());
+    hands.assign(n, Hand());
+    round = Flip7Round();
+    roundOver = false;
+
+    // The opening deal. Anyone who already has cards from a Flip Three, or was frozen, is passed over.
+    for (int k = 0; k < n && !roundOver; k++) {
+        int seat = (firstSeat + k) % n;
+        Flip7Card card;
+        if (hands[seat].active && hands[seat].cards.empty() && draw(card)) {
+            give(seat, card);
+        }
+    }
+
+    int seat = firstSeat;
+    while (!roundOver) {
+        bool anyActive = false;
+        for (const Hand& hand : hands) {
+            anyActive = anyActive || hand.active;
+        }
+        if (!anyActive) {
+            break;
+        }
+        if (hands[seat].active) {
+            round.decisions++;
+            Flip7Card card;
+            if (!wantsCard(seat)) {
+                stop(seat, false);
+            } else if (draw(card)) {
+                give(seat, card);
+            }
+        }
+        seat = (seat + 1) % n;
+    }
+
+    for (int i = 0; i < n; i++) {
+        round.scores.push_back(hands[i].score());
+        scores[i] += hands[i].score();
+        for (const Flip7Card& card : hands[i].cards) {
+            deck.discard(card);
+        }
+    }
+    firstSeat = (firstSeat + 1) % n;
+    return round;
+}
+
+bool Flip7Table::draw(Flip7Card& card) {
+    if (!deck.draw(rng, card)) {
+        roundOver = true; // Every card is on the table. Everyone still in banks what they have.
+        return false;
+    }
+    round.cards++;
+    return true;
+}
+
+void Flip7Table::give(int seat, const Flip7Card& card) {
+    Hand& hand = hands[seat];
+    switch (card.kind) {
+        case Flip7CardKind::Number:
+            hand.cards.push_back(card);
+            if (hand.numbers & (1 << card.value)) {
+                if (hand.secondChance) {
+                    hand.secondChance = false; // It and the duplicate are set aside. Both stay out until the round ends.
+                } else {
+                    stop(seat, true);
+                }
+                return;
+            }
+            hand.numbers |= 1 << card.value;
+            hand.count++;
+            hand.sum += card.value;
+            if (hand.count == flip7Numbers) {
+                round.flip7 = true;
+                roundOver = true;
+            }
+            return;
+
+        case Flip7CardKind::Plus:
+            hand.cards.push_back(card);
+            hand.plus += card.value;
+            return;
+
+        case Flip7CardKind::TimesTwo:
+            hand.cards.push_back(card);
+            hand.timesTwo = true;
+            return;
+
+        case Flip7CardKind::SecondChance:
+            if (!hand.secondChance) {
+                hand.cards.push_back(card);
+                hand.secondChance = true;
+                return;
+            }
+            for (int k = 1; k < static_cast<int>(hands.size()); k++) {
+                int other = (seat + k) % hands.size();
+                if (hands[other].active && !hands[other].secondChance) {
+                    hands[other].cards.push_back(card);
+                    hands[other].secondChance = true;
+                    return;
+                }
+            }
+            hand.cards.push_back(card); // Nobody can take it, so it goes out with this player's cards.
+            return;
+
+        case Flip7CardKind::Freeze:
+        case Flip7CardKind::FlipThree:
+            hand.cards.push_back(card);
+            resolveAction(seat, card);
+            return;
+    }
+}
+
+void Flip7Table::resolveAction(int seat, const Flip7Card& card) {
+    if (card.kind == Flip7CardKind::Freeze) {
+        int target = freezeTarget(seat);
+        if (target >= 0) {
+            round.freezes++;
+            stop(target, false);
+        }
+    } else {
+        int target = flipThreeTarget(seat);
+        if (target >= 0) {
+            round.flipThrees++;
+            flipThree(target);
+        }
+    }
+}
+
+void Flip7Table::flipThree(int seat) {
+    std::vector<Flip7Card> waiting; // Freezes and Flip Threes drawn along the way.
+    for (int i = 0; i < flipThreeCards && hands[seat].active && !roundOver; i++) {
+        Flip7Card card;
+        if (!draw(card)) {
+            return;
+        }
+        if (card.kind == Flip7CardKind::Freeze || card.kind == Flip7CardKind::FlipThree) {
+            hands[seat].cards.push_back(card);
+            waiting.push_back(card);
+        } else {
+            give(seat, card);
+        }
+    }
+    for (const Flip7Card& card : waiting) {
+        if (hands[seat].active && !roundOver) {
+            resolveAction(seat, card);
+        }
+    }
+}
+
+bool Flip7Table::wantsCard(int seat) const {
+    const Flip7Strategy& strategy = *seats[seat];
+    if (strategy.stayAt > 0 && hands[seat].score() >= strategy.stayAt) {
+        return false;
+    }
+    return strategy.maxBustRisk >= 1 || bustRisk(seat) < strategy.maxBustRisk;
+}
+
+double Flip7Table::bustRisk(int seat) const {
+    const Hand& hand = hands[seat];
+    return hand.secondChance ? 0 : deck.chanceOfNumber(hand.numbers);
+}
+
+int Flip7Table::freezeTarget(int seat) const {
+    if (hands[seat].active && hands[seat].score() >= seats[seat]->freezeSelfAt) {
+        return seat;
+    }
+    int target = leader(seat);
+    if (target < 0 && hands[seat].active) {
+        target = seat;
+    }
+    return target;
+}
+
+int Flip7Table::flipThreeTarget(int seat) const {
+    // The opponent with the most to lose: the likeliest to bust, then the best round so far.
+    int target = -1;
+    for (int other = 0; other < static_cast<int>(hands.size()); other++) {
+        if (other == seat || !hands[other].active) {
+            continue;
+        }
+        if (target < 0 || bustRisk(other) > bustRisk(target) ||
+            (bustRisk(other) == bustRisk(target) && hands[other].score() > hands[target].score())) {
+            target = other;
+        }
+    }
+    if (target < 0 && hands[seat].active) {
+        target = seat; // Nobody else is left, so it has to take them itself.
+    }
+    return target;
+}
+
+int Flip7Table::leader(int except) const {
+    int best = -1;
+    for (int other = 0; other < static_cast<int>(hands.size()); other++) {
+        if (other == except || !hands[other].active) {
+            continue;
+        }
+        if (best < 0 || scores[other] + hands[other].score() > scores[best] + hands[best].score()) {
+            best = other;
+        }
+    }
+    return best;
+}
+
+void Flip7Table::stop(int seat, bool busted) {
+    hands[seat].active = false;
+    hands[seat].busted = busted;
+    if (busted) {
+        round.busts++;
+    }
+}
@@ -0,0 +1,130 @@
+// Flip7's card game on its own, without DEALR: the deck, the table's choices and the scoring. Host programs use it for
+// the odds of a round (how many cards it takes, who busts, what it scores) and of a game (how many rounds it lasts).
+//
+// The rules as printed:
+//   - 94 cards. Numbers 0-12, with as many copies of each as its value (one 0). +2, +4, +6, +8, +10 and x2, one each.
+//     Three each of Freeze, Flip Three and Second Chance.
+//   - Each round starts with one card to every player, from the player after the dealer. Then players take turns to
+//     hit or stay until nobody is left in the round.
+//   - A number a player already has busts them, unless they hold a Second Chance, which goes with the duplicate.
+//     Seven different numbers is a Flip 7: it ends the round for everyone and scores 15 more.
+//   - A round scores the sum of the numbers, doubled by x2, plus the + cards and any Flip 7 bonus. A bust scores 0.
+//   - Freeze: whoever draws it picks an active player (possibly themselves), who banks their points and is out.
+//   - Flip Three: whoever draws it picks an active player, who takes the next three cards one at a time. A Freeze or
+//     Flip Three among them waits until the three are done, and is dropped if they bust.
+//   - Second Chance: a player holds one at most. A second goes to another active player without one, or is discarded.
+//   - Cards stay out until the round ends. The draw pile is reshuffled from the discards when it runs out.
+//   - The game ends after the round in which someone reaches the target. The highest score wins.
+#ifndef FLIP7_RULES_H
+#define FLIP7_RULES_H
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class Flip7CardKind : uint8_t { Number, Plus, TimesTwo, Freeze, FlipThree, SecondChance };
+
+struct Flip7Card {
+    Flip7CardKind kind;
+    uint8_t value; // The number, or what a + card adds.
+};
+
+class Flip7Deck {
+  public:
+    Flip7Deck(); // Empty until reset().
+
+    static const int highestNumber = 12;
+    static const int flip7Bonus = 15;
+
+    // Puts every card back and shuffles.
+    void reset(std::mt19937& rng);
+    // Reshuffles the discards into the draw pile if it's empty. Returns false if there's nothing left to draw.
+    bool draw(std::mt19937& rng, Flip7Card& card);
+    void discard(const Flip7Card& card);
+
+    // The chance the next card is one of these numbers (a bit for each), for players counting cards.
+    double chanceOfNumber(uint16_t numbers) const;
+
+    // The most one round can score with this deck: the highest seven numbers doubled, every + card and the bonus.
+    int maxRoundScore() const;
+
+  private:
+    std::vector<Flip7Card> all;
+    std::vector<Flip7Card> pile; // Drawn from the back.
+    std::vector<Flip7Card> discards;
+    int inPile[highestNumber + 1];    // Copies of each number in the draw pile.
+    int inDiscards[highestNumber + 1]; // And in the discards, which become the draw pile when it runs out.
+};
+
+// How a seat plays. Every choice the rules leave to a player is made here.
+struct Flip7Strategy {
+    const char* name;
+    int stayAt;         // Stays once the round is worth this much. 0 to never stay on points alone.
+    double maxBustRisk; // Stays once the next card would bust it this often, counting the cards seen. 1 to ignore.
+    int freezeSelfAt;   // Plays a Freeze on itself once its round is worth this much, otherwise on the leader.
+};
+
+// Named strategies for command lines: cautious, steady, bold, counter and reckless.
+const std::vector<Flip7Strategy>& flip7Strategies();
+const Flip7Strategy* findFlip7Strategy(const std::string& name);
+
+// What happened in one round.
+struct Flip7Round {
+    int cards = 0;     // Cards drawn, every one of them a throw for DEALR.
+    int decisions = 0; // Hit-or-stay prompts answered.
+    int busts = 0;
+    int freezes = 0;
+    int flipThrees = 0;
+    bool flip7 = false;
+    std::vector<int> scores; // By seat.
+};
+
+// A game in progress at a table of 2 or more seats.
+class Flip7Table {
+  public:
+    Flip7Table(const std::vector<const Flip7Strategy*>& seats, uint32_t seed);
+
+    // Plays a round and adds its scores to the totals. The first player moves one seat on each round, as DEALR does.
+    Flip7Round playRound();
+
+    const std::vector<int>& totals() const { return scores; }
+    // The seat the firmware would declare the winner at this target (checkForWinner()), or -1.
+    int winner(int target) const;
+
+  private:
+    struct Hand {
+        uint16_t numbers = 0; // Bit per number held.
+        int count = 0;
+        int sum = 0;
+        int plus = 0;
+        bool timesTwo = false;
+        bool secondChance = false;
+        bool active = true;
+        bool busted = false;
+        std::vector<Flip7Card> cards; // In front of the player until the round ends.
+        int score() const;
+    };
+
+    bool draw(Flip7Card& card); // Ends the round if the deck is out.
+    void give(int seat, const Flip7Card& card);
+    void resolveAction(int seat, const Flip7Card& card);
+    void flipThree(int seat);
+    bool wantsCard(int seat) const;
+    double bustRisk(int seat) const;
+    int freezeTarget(int seat) const;
+    int flipThreeTarget(int seat) const;
+    int leader(int except) const;
+    void stop(int seat, bool busted);
+
+    std::vector<const Flip7Strategy*> seats;
+    std::vector<int> scores;
+    std::vector<Hand> hands;
+    std::mt19937 rng;
+    Flip7Deck deck;
+    Flip7Round round;
+    int firstSeat = 0;
+    bool roundOver = false;
+};
+
+#endif // FLIP7_RULES_H
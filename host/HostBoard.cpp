@@ -0,0 +1,176 @@
+#include "HostBoard.h"
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <Wire.h>
+
+#include <deque>
+#include <random>
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+TwoWire Wire;
+
+namespace HostBoard {
+
+namespace {
+const uint32_t halCallCostUs = 4;   // Rough cost of a digitalRead/digitalWrite on a 16 MHz AVR.
+const uint32_t i2cReadCostUs = 600; // Reading the four colour channels over I2C at 100 kHz.
+const uint32_t clockReadCostUs = 2; // millis() and micros(), so loops that only watch the clock still move it.
+
+uint64_t clockUs = 0;
+int inputLevels[NUM_DIGITAL_PINS];
+uint32_t inputReadCounts[NUM_DIGITAL_PINS];
+int outputLevels[NUM_DIGITAL_PINS];
+int pwmLevels[NUM_DIGITAL_PINS];
+int analogLevels[NUM_DIGITAL_PINS];
+int servo = 90;
+bool servoOn = false;
+char display[5] = "    ";
+uint8_t brightness = 15;
+uint8_t eeprom[E2END + 1];
+std::string serialOut;
+std::deque<uint8_t> serialIn;
+std::mt19937 rng(1);
+}
+
+std::function<void(uint64_t)> onTick;
+std::function<void(uint8_t, uint16_t*, uint16_t*, uint16_t*, uint16_t*)> sensorModel;
+std::function<void(const char[4])> onDisplayFrame;
+std::function<void(uint8_t, uint16_t, uint16_t)> onEvent;
+
+uint64_t nowMicros() { return clockUs; }
+
+void advanceMicros(uint64_t us) {
+    clockUs += us;
+    if (onTick) onTick(clockUs);
+}
+
+void setInputPin(uint8_t pin, int level) { if (pin < NUM_DIGITAL_PINS) inputLevels[pin] = level; }
+uint32_t inputReads(uint8_t pin) { return pin < NUM_DIGITAL_PINS ? inputReadCounts[pin] : 0; }
+int outputPin(uint8_t pin) { return pin < NUM_DIGITAL_PINS ? outputLevels[pin] : LOW; }
+int pwmPin(uint8_t pin) { return pin < NUM_DIGITAL_PINS ? pwmLevels[pin] : 0; }
+void setAnalogInput(uint8_t pin, int value) { if (pin < NUM_DIGITAL_PINS) analogLevels[pin] = value; }
+
+int servoAngle() { return servo; }
+bool servoIsAttached() { return servoOn; }
+void servoWrite(int angle) { servo = angle; }
+void servoAttached(bool attached) { servoOn = attached; }
+
+void displayFrame(const char text[4]) {
+    memcpy(display, text, 4);
+    if (onDisplayFrame) onDisplayFrame(text);
+}
+void displayBrightness(uint8_t level) { brightness = level; }
+std::string displayText() { return std::string(display, 4); }
+uint8_t displayLevel() { return brightness; }
+
+void sensorRead(uint8_t integrationTime, uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c) {
+    static const uint32_t integrationUs[] = { 2000, 8000, 33000, 132000 };
+    advanceMicros(i2cReadCostUs + integrationUs[integrationTime & 0x3]);
+    if (sensorModel) {
+        sensorModel(integrationTime, r, g, b, c);
+    } else {
+        *r = 58; *g = 149; *b = 48; *c = 118; // Bare black table.
+    }
+}
+
+std::string& serialOutput() { return serialOut; }
+void serialInject(const std::string& bytes) { serialIn.insert(serialIn.end(), bytes.begin(), bytes.end()); }
+
+uint8_t* eepromImage() { return eeprom; }
+
+void reset() {
+    clockUs = 0;
+    for (int i = 0; i < NUM_DIGITAL_PINS; i++) {
+        inputLevels[i] = HIGH; // Buttons are pull-ups and the craw sensor idles high.
+        inputReadCounts[i] = 0;
+        outputLevels[i] = LOW;
+        pwmLevels[i] = 0;
+        analogLevels[i] = 0;
+    }
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    serialOut.clear();
+    serialIn.clear();
+    rng.seed(1);
+}
+
+int serialAvailable() { return static_cast<int>(serialIn.size()); }
+int serialRead() {
+    if (serialIn.empty()) return -1;
+    int b = serialIn.front();
+    serialIn.pop_front();
+    return b;
+}
+int serialPeek() { return serialIn.empty() ? -1 : serialIn.front(); }
+long randomBelow(long max) { return max > 0 ? static_cast<long>(rng() % static_cast<uint32_t>(max)) : 0; }
+void seedRandom(unsigned long seed) { rng.seed(seed); }
+
+int readInput(uint8_t pin) {
+    advanceMicros(halCallCostUs);
+    if (pin >= NUM_DIGITAL_PINS) {
+        return LOW;
+    }
+    inputReadCounts[pin]++;
+    return inputLevels[pin];
+}
+int readAnalog(uint8_t pin) {
+    advanceMicros(110); // One ADC conversion.
+    return pin < NUM_DIGITAL_PINS ? analogLevels[pin] : 0;
+}
+void writeOutput(uint8_t pin, int value) {
+    advanceMicros(halCallCostUs);
+    if (pin < NUM_DIGITAL_PINS) outputLevels[pin] = value;
+}
+void writePwm(uint8_t pin, int value) {
+    advanceMicros(halCallCostUs);
+    if (pin < NUM_DIGITAL_PINS) pwmLevels[pin] = value;
+}
+
+}
+
+using namespace HostBoard;
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t value) { writeOutput(pin, value); }
+int digitalRead(uint8_t pin) { return readInput(pin); }
+int analogRead(uint8_t pin) { return readAnalog(pin); }
+void analogWrite(uint8_t pin, int value) { writePwm(pin, value); }
+
+unsigned long millis() {
+    advanceMicros(clockReadCostUs);
+    return static_cast<unsigned long>(nowMicros() / 1000);
+}
+unsigned long micros() {
+    advanceMicros(clockReadCostUs);
+    return static_cast<unsigned long>(nowMicros());
+}
+
+__attribute__((weak)) void yield() {}
+
+void delay(unsigned long ms) {
+    uint64_t end = nowMicros() + static_cast<uint64_t>(ms) * 1000;
+    while (nowMicros() < end) {
+        yield();
+        uint64_t step = end - nowMicros();
+        advanceMicros(step < 1000 ? step : 1000);
+    }
+}
+void delayMicroseconds(unsigned int us) { advanceMicros(us); }
+
+long random(long max) { return randomBelow(max); }
+long random(long min, long max) { return max > min ? min + randomBelow(max - min) : min; }
+void randomSeed(unsigned long seed) { seedRandom(seed); }
+
+void hostEvent(uint8_t id, uint16_t a, uint16_t b) {
+    if (HostBoard::onEvent) HostBoard::onEvent(id, a, b);
+}
+
+void HardwareSerial::begin(unsigned long) {}
+size_t HardwareSerial::write(uint8_t b) {
+    serialOut.push_back(static_cast<char>(b));
+    return 1;
+}
+int HardwareSerial::available() { return serialAvailable(); }
+int HardwareSerial::read() { return serialRead(); }
+int HardwareSerial::peek() { return serialPeek(); }
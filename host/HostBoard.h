@@ -0,0 +1,43 @@
+// Virtual board the firmware runs against on the host: clock, pins, EEPROM, serial and display capture.
+#ifndef HOST_BOARD_H
+#define HOST_BOARD_H
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+namespace HostBoard {
+
+// Virtual clock. Every HAL call costs a little time so busy-wait loops always make progress.
+uint64_t nowMicros();
+void advanceMicros(uint64_t us);
+
+// Input pins are driven by the host; output pins and PWM are recorded for models to read.
+void setInputPin(uint8_t pin, int level);
+uint32_t inputReads(uint8_t pin); // How many times the firmware has read an input pin.
+int outputPin(uint8_t pin);
+int pwmPin(uint8_t pin);
+void setAnalogInput(uint8_t pin, int value);
+
+// Models are stepped from the clock. `onTick` runs whenever virtual time advances.
+extern std::function<void(uint64_t nowUs)> onTick;
+extern std::function<void(uint8_t integrationTime, uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c)> sensorModel;
+extern std::function<void(const char text[4])> onDisplayFrame;
+// Every logEvent() the firmware makes (Telemetry.h), with the event's id and its two fields.
+extern std::function<void(uint8_t id, uint16_t a, uint16_t b)> onEvent;
+
+int servoAngle();
+bool servoIsAttached();
+std::string displayText();
+uint8_t displayLevel();
+
+// Serial: bytes the firmware writes are collected, bytes the host queues are readable by the firmware.
+std::string& serialOutput();
+void serialInject(const std::string& bytes);
+
+uint8_t* eepromImage();
+void reset();
+
+}
+
+#endif // HOST_BOARD_H
@@ -0,0 +1,251 @@
+#include "Session.h"
+
+#include "FirmwareProbe.h"
+#include "HostBoard.h"
+
+#include <Arduino.h>
+#include "Definitions.h"
+#include "Enums.h" // dealState, for AWAITING_PLAYER_DECISION.
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+namespace {
+
+const uint8_t telemetrySync = 0xA5; // Frame layout in Telemetry.h.
+const uint8_t schemaId = 0;
+const size_t frameOverhead = 1 + 2 + 4 + 1;
+
+// Flip7's GameState values (games/Flip7.h) that bound a round.
+const int flip7ReportScore = 7;
+const int flip7ShowScores = 8;
+const int flip7GameOver = 9;
+
+}
+
+void RoundClock::observe(int gameState, double ms) {
+    if (gameState == lastState) {
+        return;
+    }
+    bool scored = gameState == flip7ReportScore || gameState == flip7GameOver;
+    if (scored && startMs >= 0 && lastState != flip7ShowScores) { // Back from the score screen isn't a new round.
+        lengthsMs.push_back(ms - startMs);
+        startMs = ms;
+    }
+    if (startMs < 0 && gameState > 0) { // Out of STARTUP, or resumed straight into a later state.
+        startMs = ms;
+    }
+    lastState = gameState;
+}
+
+bool Session::load(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "can't open " + path;
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::map<std::string, int> ids; // From the schema frames.
+    auto is = [&ids](int id, const char* name) {
+        auto found = ids.find(name);
+        return found != ids.end() && found->second == id;
+    };
+
+    bool booted = false;
+    uint32_t bootMillis = 0;
+    double lastSampleMs = -1; // In the current part.
+    uint16_t pendingR = 0, pendingG = 0;
+    RoundClock clock;
+    samples.assign(1, {});
+
+    auto startPart = [&](double ms) {
+        samples.push_back({});
+        endMs = ms;
+        lastSampleMs = -1;
+    };
+    auto addInput = [&](uint8_t pin, int level, double ms) {
+        double from = std::max(endMs, lastSampleMs);
+        inputs.push_back({ pin, level, static_cast<int>(samples.size()) - 1, static_cast<int>(samples.back().size()), ms - from });
+        startPart(ms);
+    };
+
+    size_t i = 0;
+    while (i + frameOverhead <= bytes.size()) {
+        if (bytes[i] != telemetrySync) {
+            i++; // Text reports between frames.
+            continue;
+        }
+        size_t length = bytes[i + 2];
+        size_t end = i + frameOverhead + length;
+        if (end > bytes.size()) {
+            break;
+        }
+        uint8_t sum = 0;
+        for (size_t j = i + 1; j < end - 1; j++) {
+            sum += bytes[j];
+        }
+        if (sum != bytes[end - 1]) {
+            badFrames++;
+            i++;
+            continue;
+        }
+        frames++;
+        int id = bytes[i + 1];
+        uint32_t millis = bytes[i + 3] | bytes[i + 4] << 8 | bytes[i + 5] << 16 | static_cast<uint32_t>(bytes[i + 6]) << 24;
+        const uint8_t* payload = &bytes[i + 7];
+        i = end;
+
+        if (id == schemaId) {
+            const char* name = reinterpret_cast<const char*>(payload + 1);
+            if (length > 1 && memchr(name, '\0', length - 1)) {
+                ids[name] = payload[0];
+            }
+            continue;
+        }
+        if (is(id, "BOOT")) {
+            if (booted) {
+                break; // DEALR was reset. The session ends there.
+            }
+            booted = true;
+            bootMillis = millis;
+            continue;
+        }
+        if (!booted || length > 4) {
+            continue;
+        }
+        double ms = millis - bootMillis;
+        uint16_t a = length >= 2 ? payload[0] | payload[1] << 8 : payload[0];
+        uint16_t b = length == 4 ? payload[2] | payload[3] << 8 : (length == 2 ? payload[1] : 0);
+
+        if (is(id, "SENSOR_RG")) {
+            pendingR = a;
+            pendingG = b;
+        } else if (is(id, "SENSOR_BC")) {
+            samples.back().push_back({ pendingR, pendingG, a, b });
+            lastSampleMs = ms;
+        } else if (is(id, "INPUT")) {
+            uint8_t pin = payload[0];
+            uint16_t level = payload[1] | payload[2] << 8;
+            if (pin == UV_READER) {
+                uvNoise = level;
+            } else {
+                addInput(pin, level ? HIGH : LOW, ms);
+            }
+        } else if (is(id, "CRAW")) {
+            addInput(CARD_SENS, a ? LOW : HIGH, ms);
+        } else if (is(id, "EEPROM")) {
+            eeprom.push_back({ a, static_cast<uint8_t>(b) });
+            eeprom.push_back({ static_cast<uint16_t>(a + 1), static_cast<uint8_t>(b >> 8) });
+        } else if (is(id, "DEAL_STATE")) {
+            if (payload[1] == AWAITING_PLAYER_DECISION) {
+                startPart(ms);
+            }
+        } else if (is(id, "GAME_STATE")) {
+            startPart(ms);
+            clock.observe(payload[1], ms);
+        }
+    }
+
+    roundMs = clock.rounds();
+    if (ids.empty()) {
+        error = "no schema frames, so the capture didn't start at boot";
+        return false;
+    }
+    if (!booted) {
+        error = "no BOOT frame";
+        return false;
+    }
+    if (eeprom.empty()) {
+        error = "no EEPROM frames. Was it recorded with enableSessionRecording on?";
+        return false;
+    }
+    return true;
+}
+
+SessionPlayer::SessionPlayer(const Session& session) : session(session), readsAtEdge(NUM_DIGITAL_PINS, -1) {}
+
+void SessionPlayer::attach() {
+    for (const auto& byte : session.eeprom) {
+        HostBoard::eepromImage()[byte.first] = byte.second;
+    }
+    if (session.uvNoise >= 0) {
+        HostBoard::setAnalogInput(UV_READER, session.uvNoise);
+    }
+    HostBoard::onTick = [this](uint64_t nowUs) { tick(nowUs); };
+    HostBoard::sensorModel = [this](uint8_t, uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c) { read(r, g, b, c); };
+    HostBoard::onEvent = [this](uint8_t id, uint16_t a, uint16_t b) { event(id, a, b); };
+    dealStateEvent = FirmwareProbe::eventId("DEAL_STATE");
+    gameStateEvent = FirmwareProbe::eventId("GAME_STATE");
+}
+
+bool SessionPlayer::finished() const {
+    return nextInput == session.inputs.size() && part + 1 >= static_cast<int>(session.samples.size());
+}
+
+void SessionPlayer::startPart(int next, double ms) {
+    part = next;
+    samplesTaken = 0;
+    sampleAtMs.clear();
+    partStartMs = ms;
+}
+
+void SessionPlayer::tick(uint64_t nowUs) {
+    double ms = nowUs / 1000.0;
+    while (nextInput < session.inputs.size()) {
+        const SessionInput& input = session.inputs[nextInput];
+        if (input.part > part) {
+            break;
+        }
+        if (input.part == part) {
+            if (samplesTaken < static_cast<size_t>(input.afterSample)) {
+                break;
+            }
+            double from = partStartMs;
+            if (input.afterSample > 0) {
+                from = std::max(from, sampleAtMs[input.afterSample - 1]);
+            }
+            if (ms < from + input.delayMs) {
+                break;
+            }
+        }
+        uint32_t reads = HostBoard::inputReads(input.pin);
+        if (reads == readsAtEdge[input.pin]) {
+            break; // The firmware hasn't seen the last level yet.
+        }
+        if (input.part < part) {
+            late++;
+        }
+        HostBoard::setInputPin(input.pin, input.level);
+        readsAtEdge[input.pin] = reads;
+        nextInput++;
+        startPart(input.part + 1, ms); // Back in step with the recording, even after a part it didn't have.
+    }
+}
+
+void SessionPlayer::event(uint8_t id, uint16_t, uint16_t b) {
+    double ms = HostBoard::nowMicros() / 1000.0;
+    if (id == dealStateEvent && b == AWAITING_PLAYER_DECISION) {
+        startPart(part + 1, ms);
+    } else if (id == gameStateEvent) {
+        startPart(part + 1, ms);
+        rounds.observe(b, ms);
+    }
+}
+
+void SessionPlayer::read(uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c) {
+    if (part < static_cast<int>(session.samples.size()) && samplesTaken < session.samples[part].size()) {
+        lastSample = session.samples[part][samplesTaken];
+        sampleAtMs.push_back(HostBoard::nowMicros() / 1000.0);
+    } else {
+        extra++;
+    }
+    samplesTaken++;
+    *r = lastSample.r;
+    *g = lastSample.g;
+    *b = lastSample.b;
+    *c = lastSample.c;
+}
@@ -0,0 +1,101 @@
+// A game session recorded at the table (enableSessionRecording, see SessionRecorder.h), and the model that plays it
+// back into the firmware on the host.
+//
+// Playback follows the firmware, not the recording's clock, so that a firmware change shows up as a change in time
+// instead of inputs landing in the wrong place. The session is split into parts at every input (a button or craw
+// edge), every prompt (the deal state becoming AWAITING_PLAYER_DECISION) and every game state change. The host build
+// gets the same events from logEvent() that telemetry sent, at the same points. Within each part:
+//   - The colour samples are handed out in the order they were taken. Once the firmware has used them all, it keeps
+//     getting the last one. Any it doesn't use are dropped when the part ends.
+//   - The input that ends the part waits for as many samples as came before it. It then keeps its recorded delay
+//     from the later of the part's start and that sample.
+// An edge also waits until the firmware has read the pin's previous level, so a press can't come and go inside a
+// blocking seek. Game state changes are logged once a button's handler returns, so the table answers each prompt as
+// long after it appears as it did at the table, and anything slower in the firmware delays everything after it.
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct SessionSample {
+    uint16_t r, g, b, c;
+};
+
+struct SessionInput {
+    uint8_t pin;
+    int level;
+    int part;        // The part it ends. Part 0 starts at boot.
+    int afterSample; // Samples taken in its part before it.
+    double delayMs;  // From the later of the part's start and that sample.
+};
+
+// Splits Flip7's game state changes, as logged by checkState(), into rounds. A round ends when the scores are
+// reported or the game is won, and the next one starts there. The first starts when the game leaves STARTUP, which
+// is logged once the players are registered.
+class RoundClock {
+  public:
+    void observe(int gameState, double ms);
+    const std::vector<double>& rounds() const { return lengthsMs; }
+
+  private:
+    int lastState = -1;
+    double startMs = -1;
+    std::vector<double> lengthsMs;
+};
+
+struct Session {
+    std::vector<std::pair<uint16_t, uint8_t>> eeprom; // EEPROM contents at boot, as address and byte.
+    int uvNoise = -1;                                  // The analogRead() that seeded random(), if recorded.
+    std::vector<std::vector<SessionSample>> samples;   // By part. There's always at least one part.
+    std::vector<SessionInput> inputs;                  // In the order they happened.
+    double endMs = 0;                                  // When the last part started, in ms from boot.
+    std::vector<double> roundMs;                       // Each round's length at the table.
+    int frames = 0;
+    int badFrames = 0;
+
+    // Reads a raw telemetry capture, from the first boot up to the next one. The capture has to include the schema
+    // frames DEALR sends at boot, since the events are looked up by name.
+    bool load(const std::string& path, std::string& error);
+};
+
+class SessionPlayer {
+  public:
+    explicit SessionPlayer(const Session& session);
+
+    // Loads the recorded EEPROM and UV reading into HostBoard and installs the tick, sensor and event hooks. Call
+    // before setup(). Only one SessionPlayer can be attached at a time.
+    void attach();
+
+    // Every input has been played and the firmware has reached the recording's last part.
+    bool finished() const;
+    int partsReached() const { return part; }
+    double endMs() const { return partStartMs; } // When the latest part started, in ms from boot.
+    const std::vector<double>& roundMs() const { return rounds.rounds(); }
+    int lateInputs() const { return late; } // Played late, after a prompt or state change the recording didn't have.
+    int extraSamples() const { return extra; } // Reads beyond what the recording had for their part.
+
+  private:
+    void tick(uint64_t nowUs);
+    void read(uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c);
+    void event(uint8_t id, uint16_t a, uint16_t b);
+    void startPart(int next, double ms);
+
+    const Session& session;
+    int part = 0;
+    size_t nextInput = 0;
+    size_t samplesTaken = 0;         // In the current part.
+    std::vector<double> sampleAtMs;  // When each of the current part's recorded samples was taken.
+    double partStartMs = 0;
+    int dealStateEvent = -1;         // Event ids, from FirmwareProbe::eventId().
+    int gameStateEvent = -1;
+    std::vector<int64_t> readsAtEdge; // HostBoard::inputReads() for each pin when its level was last changed.
+    SessionSample lastSample = { 58, 149, 48, 118 }; // Black, until the recording says otherwise.
+    RoundClock rounds;
+    int late = 0;
+    int extra = 0;
+};
+
+#endif // SESSION_H
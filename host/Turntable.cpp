@@ -0,0 +1,133 @@
+#include "Turntable.h"
+
+#include "HostBoard.h"
+
+#include <Arduino.h>
+#include "ColorNames.h" // Default tag colours, the same ones the firmware matches against.
+#include "Definitions.h"
+
+#include <cmath>
+
+namespace {
+const uint8_t highSpeedPwm = 255; // highSpeed, mediumSpeed and lowSpeed in the sketch.
+const uint8_t mediumSpeedPwm = 220;
+const uint8_t lowSpeedPwm = 180;
+const int servoFeedingAbove = 120; // slideCard() writes 150 to feed, 30 to retract and 90 to stop.
+}
+
+Turntable::Turntable(const TurntableConfig& config)
+    : config(config), rng(config.seed), cardsLeft(config.deckCards) {}
+
+void Turntable::attach() {
+    lastUs = HostBoard::nowMicros();
+    HostBoard::onTick = [this](uint64_t nowUs) { step(nowUs); };
+    HostBoard::sensorModel = [this](uint8_t, uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c) { read(r, g, b, c); };
+}
+
+namespace {
+const double integrateEveryMs = 0.25; // Far finer than anything the motors or the sensor can resolve.
+const double stillBelowDegPerSec = 0.5;
+}
+
+void Turntable::step(uint64_t nowUs) {
+    pendingMs += (nowUs - lastUs) / 1000.0;
+    lastUs = nowUs;
+    if (pendingMs >= integrateEveryMs) {
+        integrate();
+    }
+}
+
+void Turntable::integrate() {
+    double dtMs = pendingMs;
+    pendingMs = 0;
+    if (dtMs <= 0) {
+        return;
+    }
+
+    bool cw = HostBoard::outputPin(MOTOR_2_PIN_1) == HIGH;
+    bool ccw = HostBoard::outputPin(MOTOR_2_PIN_2) == HIGH;
+    int pwm = HostBoard::pwmPin(MOTOR_2_PWM);
+    auto remapped = config.pwmRemap.find(pwm);
+    int drive = remapped == config.pwmRemap.end() ? pwm : remapped->second;
+    double target = 0;
+    if (cw != ccw && drive > config.stallPwm) {
+        target = config.fullSpeedDegPerSec * (drive - config.stallPwm) / (255.0 - config.stallPwm);
+        if (ccw) {
+            target = -target;
+        }
+    }
+    double lagMs = (cw != ccw) ? config.spinUpMs : config.coastMs;
+    double settled = speedDegPerSec + (target - speedDegPerSec) * (1.0 - std::exp(-dtMs / lagMs));
+    double travel = (speedDegPerSec + settled) / 2.0 * dtMs / 1000.0;
+    angleDeg += travel;
+    speedDegPerSec = std::fabs(settled) < stillBelowDegPerSec && target == 0 ? 0 : settled;
+
+    used.degrees += std::fabs(travel);
+    if (cw != ccw) {
+        if (pwm >= highSpeedPwm) {
+            used.highMs += dtMs;
+        } else if (pwm >= mediumSpeedPwm) {
+            used.mediumMs += dtMs;
+        } else if (pwm >= lowSpeedPwm) {
+            used.lowMs += dtMs;
+        }
+    } else if (speedDegPerSec != 0) {
+        used.coastMs += dtMs;
+    }
+
+    stepCraw(dtMs);
+}
+
+void Turntable::stepCraw(double dtMs) {
+    bool flywheelForward = HostBoard::outputPin(MOTOR_1_PIN_2) == HIGH && HostBoard::pwmPin(MOTOR_1_PWM) > 0;
+    bool feeding = HostBoard::servoIsAttached() && HostBoard::servoAngle() > servoFeedingAbove;
+    if (flywheelForward) {
+        used.throwMs += dtMs;
+    }
+
+    if (feedingMs < 0) {
+        feedingMs = std::fmin(feedingMs + dtMs, 0.0); // Gap before the next card can move.
+    } else if (feeding && flywheelForward && cardsLeft > 0) {
+        feedingMs += dtMs;
+    } else if (feedingMs < config.feedMs) {
+        feedingMs = 0; // A card that hadn't reached the craw is pulled back.
+    }
+
+    bool inCraw = feedingMs >= config.feedMs && feedingMs < config.feedMs + config.crawMs;
+    if (feedingMs >= config.feedMs + config.crawMs) {
+        cardsLeft--;
+        used.cards++;
+        feedingMs = -config.cardGapMs;
+    }
+    HostBoard::setInputPin(CARD_SENS, inCraw ? LOW : HIGH); // The IR sensor pulls low while a card blocks it.
+}
+
+int Turntable::seatUnderSensor() const {
+    int seats = static_cast<int>(config.seatColors.size());
+    if (seats == 0) {
+        return -1;
+    }
+    double spacing = 360.0 / seats;
+    double a = std::fmod(std::fmod(angleDeg, 360.0) + 360.0, 360.0);
+    int seat = static_cast<int>(std::floor(a / spacing + 0.5)) % seats;
+    double offset = std::fabs(a - seat * spacing);
+    offset = std::fmin(offset, 360.0 - offset);
+    double width = config.seatColors[seat] > 4 ? config.wideTagWidthDeg : config.tagWidthDeg;
+    return offset <= width / 2 ? seat : -1;
+}
+
+void Turntable::read(uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c) {
+    integrate();
+    int seat = seatUnderSensor();
+    const RGBColor& base = defaultColors[seat < 0 ? 0 : config.seatColors[seat]];
+    double gain = seat < 0 ? 1.0 : config.tagGain;
+    double clear = seat < 0 ? base.avgC : base.avgC * gain;
+    auto sample = [this](double value, double sigma) {
+        double v = value + noise(rng) * sigma;
+        return static_cast<uint16_t>(v < 0 ? 0 : (v > 65535 ? 65535 : v));
+    };
+    *r = sample(base.r * gain, config.noiseCounts);
+    *g = sample(base.g * gain, config.noiseCounts);
+    *b = sample(base.b * gain, config.noiseCounts);
+    *c = sample(clear, config.clearNoiseCounts);
+}
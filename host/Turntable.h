@@ -0,0 +1,88 @@
+// Physical model of DEALR for host runs: the yaw motor turning the table, the ring of colour tags under the sensor,
+// the sensor's noise, and cards leaving through the craw. It hooks into HostBoard's clock and sensor, so the firmware
+// runs against it unchanged.
+#ifndef TURNTABLE_H
+#define TURNTABLE_H
+
+#include <stdint.h>
+#include <map>
+#include <random>
+#include <vector>
+
+struct TurntableConfig {
+    // Yaw motor. Speed rises linearly from stallPwm to full speed at PWM 255, and the table follows it with a
+    // first-order lag: spinUpMs while driven, coastMs once both direction pins are low (the driver lets it coast).
+    double fullSpeedDegPerSec = 84.0; // A lap in about 4.3 s at highSpeed.
+    int stallPwm = 150;               // Below this the motor can't turn the table.
+    double spinUpMs = 80.0;
+    double coastMs = 60.0;
+
+    // Drives the motor at a different PWM than the firmware asked for, e.g. { 220, 255 } to see what raising
+    // mediumSpeed would do without rebuilding. Usage still counts the time under the firmware's value.
+    std::map<int, int> pwmRemap;
+
+    // Tag ring. Seat i has tag colour seatColors[i] (ColorNames.h indices), centred at i * 360 / seats degrees from
+    // where the table starts. Colours above 4 are the wider home-printed tags.
+    std::vector<uint8_t> seatColors = { 1, 2, 3, 4 };
+    double tagWidthDeg = 10.0; // 1/36 of the circle, per the note on colour sensing in setup().
+    double wideTagWidthDeg = 13.0;
+
+    // Colour sensor. Tags read as their default colour (ColorNames.h) scaled by tagGain, black as its default, with
+    // Gaussian noise on every channel.
+    double tagGain = 3.0;
+    double noiseCounts = 2.0;
+    double clearNoiseCounts = 6.0;
+
+    // Card path. While the feed servo pushes (angle above 120) and the flywheel runs forward, a card reaches the craw
+    // after feedMs, blocks the IR sensor for crawMs, and the next one follows cardGapMs later.
+    double feedMs = 180.0;
+    double crawMs = 70.0;
+    double cardGapMs = 250.0;
+    int deckCards = 94;
+
+    uint32_t seed = 1;
+};
+
+class Turntable {
+  public:
+    // Where the run's time went, from the motor and flywheel pins. Filled in as virtual time passes.
+    struct Usage {
+        double highMs = 0;   // Yaw driven at highSpeed (seeks and spins).
+        double mediumMs = 0; // Yaw driven at mediumSpeed (single steps, initialising to red).
+        double lowMs = 0;    // Yaw driven at lowSpeed (fine adjusts, moving off a tag).
+        double coastMs = 0;  // Not driven, but the table still turning.
+        double throwMs = 0;  // Flywheel running.
+        double degrees = 0;  // Total table travel.
+        int cards = 0;
+    };
+
+    explicit Turntable(const TurntableConfig& config);
+
+    // Installs the model as HostBoard's tick and sensor hooks. Only one Turntable can be attached at a time.
+    void attach();
+
+    double angle() const { return angleDeg; }
+    double speed() const { return speedDegPerSec; }
+    int seatUnderSensor() const; // -1 over black.
+    const Usage& usage() const { return used; }
+    void clearUsage() { used = Usage(); }
+
+  private:
+    void step(uint64_t nowUs);
+    void integrate();
+    void read(uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c);
+    void stepCraw(double dtMs);
+
+    TurntableConfig config;
+    std::mt19937 rng;
+    std::normal_distribution<double> noise{ 0.0, 1.0 };
+    uint64_t lastUs = 0;
+    double pendingMs = 0; // Time not yet integrated. The firmware's clock moves in steps of a few microseconds.
+    double angleDeg = 0;
+    double speedDegPerSec = 0;
+    double feedingMs = 0; // How long the current card has been on its way. Negative while waiting for the next.
+    int cardsLeft = 0;
+    Usage used;
+};
+
+#endif // TURNTABLE_H
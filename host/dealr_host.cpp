@@ -0,0 +1,196 @@
+// Runs the DEALR firmware on the host, driven by a small script.
+//
+//     dealr_host [script] [--serial-out file] [--limit ms]
+//
+// The script comes from the file, or from stdin when no file is given. One command per line, '#' starts a comment:
+//
+//     wait <ms>             Run the firmware for this much virtual time.
+//     press <g|b|y|r> [ms]  Hold a button down for ms (default 100), then let go. Hold it longer for a long press.
+//     hold <g|b|y|r>        Hold a button down until "release". Use it before "boot" to hold a button at power-on.
+//     release <g|b|y|r>
+//     pin <pin> <0|1>       Drive any input pin, the craw sensor for example.
+//     serial <text>         Queue a line on Serial, for the console (enableConsole in Config.h).
+//     show                  Print the virtual time and what the display shows.
+//     expect <text>         Run the firmware until the display shows text, up to 5 s. Text scrolls by four digits at a
+//                           time, so give at most four characters, "PICK" for example. The run fails if it never shows.
+//     boot                  Run setup(). The script starts with it if it doesn't say when.
+//
+// Nothing turns the table, so the colour sensor always sees a bare black table. Anything that waits for a tag blocks
+// until --limit (virtual ms, default 600000), and the run ends there with exit code 2.
+
+#include "HostBoard.h"
+
+#include <Arduino.h>
+#include "Definitions.h" // Button pins only. The firmware headers that define globals stay in firmware.cpp.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+struct VirtualTimeLimit {};
+
+uint64_t limitUs = 600000ULL * 1000;
+const unsigned long expectMs = 5000;
+bool booted = false;
+
+void show() {
+    printf("%10.3f [%s]\n", HostBoard::nowMicros() / 1e6, HostBoard::displayText().c_str());
+}
+
+int buttonPin(const std::string& name) {
+    switch (name.empty() ? ' ' : name[0]) {
+        case 'g': return BUTTON_PIN_1;
+        case 'b': return BUTTON_PIN_2;
+        case 'y': return BUTTON_PIN_3;
+        case 'r': return BUTTON_PIN_4;
+        default: return -1;
+    }
+}
+
+void boot() {
+    if (!booted) {
+        booted = true;
+        setup();
+    }
+}
+
+void run(unsigned long ms) {
+    boot();
+    uint64_t until = HostBoard::nowMicros() + static_cast<uint64_t>(ms) * 1000;
+    while (HostBoard::nowMicros() < until) {
+        loop();
+    }
+}
+
+bool runUntilShown(const std::string& text) {
+    boot();
+    uint64_t until = HostBoard::nowMicros() + static_cast<uint64_t>(expectMs) * 1000;
+    while (HostBoard::displayText().find(text) == std::string::npos) {
+        if (HostBoard::nowMicros() >= until) {
+            return false;
+        }
+        loop();
+    }
+    return true;
+}
+
+bool runCommand(const std::string& line, int lineNumber) {
+    std::istringstream in(line);
+    std::string command;
+    if (!(in >> command) || command[0] == '#') {
+        return true;
+    }
+    if (command == "wait") {
+        unsigned long ms = 0;
+        in >> ms;
+        run(ms);
+    } else if (command == "press" || command == "hold" || command == "release") {
+        std::string name;
+        in >> name;
+        int pin = buttonPin(name);
+        if (pin < 0) {
+            fprintf(stderr, "line %d: unknown button '%s'\n", lineNumber, name.c_str());
+            return false;
+        }
+        if (command == "release") {
+            HostBoard::setInputPin(pin, HIGH);
+        } else {
+            HostBoard::setInputPin(pin, LOW); // Buttons pull the pin low.
+        }
+        if (command == "press") {
+            unsigned long ms = 100;
+            in >> ms;
+            run(ms);
+            HostBoard::setInputPin(pin, HIGH);
+        }
+    } else if (command == "pin") {
+        int pin = 0;
+        int level = 0;
+        in >> pin >> level;
+        HostBoard::setInputPin(pin, level ? HIGH : LOW);
+    } else if (command == "serial") {
+        std::string text;
+        std::getline(in >> std::ws, text);
+        HostBoard::serialInject(text + "\n");
+    } else if (command == "show") {
+        show();
+    } else if (command == "expect") {
+        std::string text;
+        std::getline(in >> std::ws, text);
+        if (!runUntilShown(text)) {
+            fprintf(stderr, "line %d: expected [%s] within %lu ms, the display shows [%s]\n", lineNumber, text.c_str(),
+                    expectMs, HostBoard::displayText().c_str());
+            return false;
+        }
+    } else if (command == "boot") {
+        boot();
+    } else {
+        fprintf(stderr, "line %d: unknown command '%s'\n", lineNumber, command.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* scriptPath = nullptr;
+    const char* serialPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--serial-out" && i + 1 < argc) {
+            serialPath = argv[++i];
+        } else if (arg == "--limit" && i + 1 < argc) {
+            limitUs = strtoull(argv[++i], nullptr, 10) * 1000;
+        } else if (arg[0] != '-' && !scriptPath) {
+            scriptPath = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [script] [--serial-out file] [--limit ms]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::ifstream file;
+    if (scriptPath) {
+        file.open(scriptPath);
+        if (!file) {
+            fprintf(stderr, "can't open %s\n", scriptPath);
+            return 1;
+        }
+    }
+    std::istream& script = scriptPath ? file : std::cin;
+
+    HostBoard::reset();
+    HostBoard::onTick = [](uint64_t nowUs) {
+        if (nowUs > limitUs) {
+            throw VirtualTimeLimit();
+        }
+    };
+
+    int status = 0;
+    try {
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(script, line)) {
+            if (!runCommand(line, ++lineNumber)) {
+                status = 1;
+                break;
+            }
+        }
+        boot();
+    } catch (const VirtualTimeLimit&) {
+        fprintf(stderr, "virtual time limit reached\n");
+        status = 2;
+    }
+    show();
+
+    if (serialPath) {
+        std::ofstream out(serialPath, std::ios::binary);
+        out << HostBoard::serialOutput();
+    }
+    return status;
+}
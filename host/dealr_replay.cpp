@@ -0,0 +1,336 @@
+// Plays recorded table sessions back through the firmware, and checks each one against its golden result.
+//
+//     dealr_replay [--update] [--tolerance percent] capture...
+//
+// A capture is the raw Serial stream from DEALR built with enableTelemetry and enableSessionRecording on, saved from
+// power-on to the end of the session. For example, with stty set to 115200 baud, use `cat /dev/ttyUSB0 > game.bin`.
+// Session.h explains how the inputs are timed on playback.
+//
+// For each capture the report gives the session's total time (boot to the start of the last part, see Session.h) and
+// each round's time, both as recorded and as replayed, and Flip7's state at the end. The golden result lives next to the capture
+// as <capture>.golden. It's written the first time, or with --update. After that, a replay fails when:
+//   - the game state, players, colours, scores or number of rounds differ, or
+//   - the total time or any round is more than --tolerance percent (default 0.5) slower than the golden result.
+// Playback is deterministic, so a golden result only changes when the firmware does. A directory of captures from
+// real games is a regression suite: `dealr_replay sessions/*.bin`. The exit code is 1 if any capture fails.
+//
+// Every capture is replayed in its own process, since the firmware's globals can't be reset between runs.
+
+#include "HostBoard.h"
+#include "FirmwareProbe.h"
+#include "Session.h"
+
+#include <Arduino.h>
+#include "ColorNames.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int maxRounds = 64;
+const int maxPlayers = 8;
+const uint64_t settleMs = 2000; // Run after the last input, before the final state is read.
+const char* const flip7States[] = {
+    "STARTUP", "DEALSPECIAL", "ACTION", "PICK", "PICKSPECIAL", "PICKPLAYER", "ENTERSCORE", "REPORTSCORE", "SHOWSCORES",
+    "GAMEOVER",
+};
+
+// Where a session ends up. Written to and read from the golden file, and passed back from the replay process.
+struct Outcome {
+    double totalMs = 0;
+    int rounds = 0;
+    double roundMs[maxRounds] = {};
+    int gameState = -1;
+    int players = 0;
+    uint8_t colors[maxPlayers] = {};
+    int16_t scores[maxPlayers] = {};
+};
+
+// What the replay process sends back. Plain data, so it can go through a pipe.
+struct ReplayResult {
+    bool ok = false;
+    char failure[96] = "";
+    Outcome recorded; // Only the times are known for the recording.
+    Outcome replayed;
+    int inputs = 0;
+    int samples = 0;
+    int badFrames = 0;
+    int lateInputs = 0;
+    int extraSamples = 0;
+};
+
+struct StalledReplay {};
+
+void copyRounds(const std::vector<double>& from, Outcome& to) {
+    to.rounds = std::min(static_cast<int>(from.size()), maxRounds);
+    for (int i = 0; i < to.rounds; i++) {
+        to.roundMs[i] = from[i];
+    }
+}
+
+ReplayResult replay(const std::string& path) {
+    ReplayResult result;
+    Session session;
+    std::string error;
+    if (!session.load(path, error)) {
+        snprintf(result.failure, sizeof(result.failure), "%s", error.c_str());
+        return result;
+    }
+    result.inputs = static_cast<int>(session.inputs.size());
+    for (const auto& part : session.samples) {
+        result.samples += static_cast<int>(part.size());
+    }
+    result.badFrames = session.badFrames;
+    result.recorded.totalMs = session.endMs;
+    copyRounds(session.roundMs, result.recorded);
+
+    // A replay that needs far longer than the recording has lost its way, most likely waiting for a tag.
+    uint64_t limitUs = static_cast<uint64_t>((result.recorded.totalMs * 2 + 60000) * 1000);
+    HostBoard::reset();
+    SessionPlayer player(session);
+    player.attach();
+    auto playerTick = HostBoard::onTick;
+    HostBoard::onTick = [playerTick, limitUs](uint64_t nowUs) {
+        playerTick(nowUs);
+        if (nowUs > limitUs) {
+            throw StalledReplay();
+        }
+    };
+
+    try {
+        setup();
+        while (!player.finished()) {
+            loop();
+        }
+        result.replayed.totalMs = player.endMs();
+        uint64_t settledUs = HostBoard::nowMicros() + settleMs * 1000;
+        while (HostBoard::nowMicros() < settledUs) {
+            loop(); // Whatever the last input started, such as a score being entered, finishes in here.
+        }
+    } catch (const StalledReplay&) {
+        snprintf(result.failure, sizeof(result.failure), "stalled in part %d of %zu", player.partsReached() + 1,
+            session.samples.size());
+        return result;
+    }
+
+    copyRounds(player.roundMs(), result.replayed);
+    result.replayed.gameState = FirmwareProbe::gameState();
+    result.replayed.players = std::min<int>(FirmwareProbe::playerCount(), maxPlayers);
+    for (int i = 0; i < result.replayed.players; i++) {
+        result.replayed.colors[i] = FirmwareProbe::playerColor(i);
+        result.replayed.scores[i] = FirmwareProbe::playerScore(i);
+    }
+    result.lateInputs = player.lateInputs();
+    result.extraSamples = player.extraSamples();
+    result.ok = true;
+    return result;
+}
+
+ReplayResult replayInChild(const std::string& path) {
+    ReplayResult result;
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        snprintf(result.failure, sizeof(result.failure), "pipe failed");
+        return result;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        ReplayResult child = replay(path);
+        ssize_t written = write(fds[1], &child, sizeof(child));
+        _exit(written == sizeof(child) ? 0 : 1);
+    }
+    close(fds[1]);
+    if (pid < 0) {
+        snprintf(result.failure, sizeof(result.failure), "fork failed");
+    } else if (read(fds[0], &result, sizeof(result)) != sizeof(result)) {
+        result = ReplayResult();
+        snprintf(result.failure, sizeof(result.failure), "replay crashed");
+    }
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+    return result;
+}
+
+std::string stateName(int state) {
+    if (state >= 0 && state < static_cast<int>(sizeof(flip7States) / sizeof(flip7States[0]))) {
+        return flip7States[state];
+    }
+    return state < 0 ? "not in a game" : std::to_string(state);
+}
+
+std::string describe(const Outcome& o) {
+    std::string text = stateName(o.gameState);
+    for (int i = 0; i < o.players; i++) {
+        const char* name = o.colors[i] < TOTAL_COLORS ? colorNames[o.colors[i]] : "????";
+        text += (i == 0 ? ", " : " ") + std::string(name, 4) + "=" + std::to_string(o.scores[i]);
+    }
+    return text;
+}
+
+bool sameState(const Outcome& a, const Outcome& b) {
+    if (a.gameState != b.gameState || a.players != b.players || a.rounds != b.rounds) {
+        return false;
+    }
+    for (int i = 0; i < a.players; i++) {
+        if (a.colors[i] != b.colors[i] || a.scores[i] != b.scores[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool writeGolden(const std::string& path, const Outcome& o) {
+    std::ofstream out(path);
+    out << "# dealr_replay golden result. Rewrite with --update when a change is meant to alter it.\n";
+    out << "total_ms " << std::lround(o.totalMs) << "\n";
+    out << "round_ms";
+    for (int i = 0; i < o.rounds; i++) {
+        out << " " << std::lround(o.roundMs[i]);
+    }
+    out << "\nstate " << o.gameState << "\nplayers " << o.players << "\n";
+    for (int i = 0; i < o.players; i++) {
+        out << "player " << static_cast<int>(o.colors[i]) << " " << o.scores[i] << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool readGolden(const std::string& path, Outcome& o) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    int listed = 0; // Players read so far.
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "total_ms") {
+            fields >> o.totalMs;
+        } else if (key == "round_ms") {
+            double ms;
+            while (o.rounds < maxRounds && fields >> ms) {
+                o.roundMs[o.rounds++] = ms;
+            }
+        } else if (key == "state") {
+            fields >> o.gameState;
+        } else if (key == "players") {
+            fields >> o.players;
+            o.players = std::min(std::max(o.players, 0), maxPlayers);
+        } else if (key == "player") {
+            int color = 0, score = 0;
+            fields >> color >> score;
+            if (listed < o.players) {
+                o.colors[listed] = color;
+                o.scores[listed] = score;
+                listed++;
+            }
+        }
+    }
+    return true;
+}
+
+// Returns how much slower replayed is than golden, as a fraction. Negative when it's faster.
+double slowdown(double replayed, double golden) {
+    return golden > 0 ? replayed / golden - 1.0 : 0.0;
+}
+
+void printTime(const char* label, double recorded, double replayed, const double* golden) {
+    printf("  %-12s %9.1f s %9.1f s", label, recorded / 1000.0, replayed / 1000.0);
+    if (golden) {
+        printf(" %9.1f s %+6.1f%%", *golden / 1000.0, 100.0 * slowdown(replayed, *golden));
+    }
+    printf("\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool update = false;
+    double tolerance = 0.5;
+    std::vector<std::string> captures;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--update") {
+            update = true;
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (!arg.empty() && arg[0] != '-') {
+            captures.push_back(arg);
+        } else {
+            fprintf(stderr, "usage: %s [--update] [--tolerance percent] capture...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (captures.empty()) {
+        fprintf(stderr, "usage: %s [--update] [--tolerance percent] capture...\n", argv[0]);
+        return 1;
+    }
+
+    int failed = 0;
+    for (const std::string& capture : captures) {
+        ReplayResult r = replayInChild(capture);
+        if (!r.ok) {
+            printf("%s: FAIL, %s\n\n", capture.c_str(), r.failure);
+            failed++;
+            continue;
+        }
+        std::string goldenPath = capture + ".golden";
+        Outcome golden;
+        bool haveGolden = !update && readGolden(goldenPath, golden);
+
+        printf("%s: %d inputs, %d samples, %d rounds\n", capture.c_str(), r.inputs, r.samples, r.replayed.rounds);
+        printf("  %-12s %11s %11s%s\n", "", "recorded", "replayed", haveGolden ? "      golden" : "");
+        printTime("total", r.recorded.totalMs, r.replayed.totalMs, haveGolden ? &golden.totalMs : nullptr);
+        for (int i = 0; i < r.replayed.rounds; i++) {
+            char label[16];
+            snprintf(label, sizeof(label), "round %d", i + 1);
+            bool inGolden = haveGolden && i < golden.rounds;
+            printTime(label, i < r.recorded.rounds ? r.recorded.roundMs[i] : 0, r.replayed.roundMs[i],
+                inGolden ? &golden.roundMs[i] : nullptr);
+        }
+        printf("  final: %s\n", describe(r.replayed).c_str());
+        if (r.lateInputs || r.extraSamples || r.badFrames) {
+            printf("  %d inputs played late, %d reads past the recorded samples, %d bad frames in the capture\n",
+                r.lateInputs, r.extraSamples, r.badFrames);
+        }
+
+        if (!haveGolden) {
+            bool written = writeGolden(goldenPath, r.replayed);
+            printf("  %s %s\n\n", written ? "wrote" : "FAIL, couldn't write", goldenPath.c_str());
+            failed += written ? 0 : 1;
+            continue;
+        }
+        std::string why;
+        if (!sameState(r.replayed, golden)) {
+            why = "the game ended differently. Golden: " + describe(golden) + ", " + std::to_string(golden.rounds) + " rounds";
+        } else if (slowdown(r.replayed.totalMs, golden.totalMs) * 100 > tolerance) {
+            why = "the session is slower than golden";
+        } else {
+            for (int i = 0; i < r.replayed.rounds && why.empty(); i++) {
+                if (slowdown(r.replayed.roundMs[i], golden.roundMs[i]) * 100 > tolerance) {
+                    why = "round " + std::to_string(i + 1) + " is slower than golden";
+                }
+            }
+        }
+        printf("  %s%s\n\n", why.empty() ? "PASS" : "FAIL, ", why.c_str());
+        failed += why.empty() ? 0 : 1;
+    }
+    if (captures.size() > 1) {
+        printf("%zu of %zu sessions passed\n", captures.size() - failed, captures.size());
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+// The whole sketch as one translation unit, the way the Arduino IDE builds it, but against the stand-ins in shim/.
+#include "../Flip7DealerMain/Flip7DealerMain.ino"
+
+#include "FirmwareProbe.h"
+
+namespace FirmwareProbe {
+
+uint8_t dealState() { return currentDealState; }
+bool awaitingDecision() { return currentDealState == AWAITING_PLAYER_DECISION; }
+int gameState() { return currentGamePtr ? currentGamePtr->getStateId() : -1; }
+uint8_t activeColor() { return ::activeColor; }
+bool errorShowing() { return currentDisplayState == ERROR || currentDealState == RESET_DEALR; }
+int eventId(const char* name) {
+    for (int id = 0; id < NUM_TELEMETRY_EVENTS; id++) {
+        if (strcmp(telemetryEvents[id].name, name) == 0) {
+            return id;
+        }
+    }
+    return -1;
+}
+uint8_t playerCount() { return currentGamePtr ? currentGamePtr->getPlayerCount() : 0; }
+uint8_t playerColor(uint8_t player) { return currentGamePtr ? currentGamePtr->getPlayerColor(player) : 0; }
+int16_t playerScore(uint8_t player) { return currentGamePtr ? currentGamePtr->getPlayerScore(player) : 0; }
+uint8_t integrationTime() { return sensor.getIntegrationTime(); }
+uint8_t debounceCount() { return ::debounceCount; }
+float spikeThreshold() { return ::spikeThreshold; }
+uint8_t highSpeed() { return ::highSpeed; }
+uint8_t mediumSpeed() { return ::mediumSpeed; }
+uint8_t lowSpeed() { return ::lowSpeed; }
+uint8_t numSamples() { return ::numSamples; }
+
+}
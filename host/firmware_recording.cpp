@@ -0,0 +1,11 @@
+// The sketch with telemetry and session recording turned on, as if Config.h said so, for host programs that make
+// captures dealr_replay can play back. Config.h is read first, and its include guard keeps the sketch's own
+// #include from undoing the overrides.
+#include "../Flip7DealerMain/Config.h"
+
+#undef enableTelemetry
+#define enableTelemetry true
+#undef enableSessionRecording
+#define enableSessionRecording true
+
+#include "firmware.cpp"
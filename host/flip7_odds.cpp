@@ -0,0 +1,416 @@
+// Plays Flip7's card game on its own (Flip7Rules.h), millions of rounds at a time, for the numbers behind DEALR's
+// defaults: how long a round runs, how often players bust, what a round scores and how many rounds a game lasts.
+//
+//     dealr_flip7_odds [--players 2-8] [--games n] [--table strategy,...] [--target score] [--threads n] [--seed n]
+//                      [--progmem]
+//
+// Every game is played until someone reaches 1000, just past the highest target DEALR offers, and the round in which
+// the lead first reached each target from 200 up is noted. The strategies don't look at the target, so that's the
+// length the game would have had at each one. Minutes come from rough costs for each card, prompt and score entry. Seat i plays strategy i of --table, wrapping around (all "steady" by default).
+// With more than one strategy at the table, it also prints how often a seat playing each one wins at --target.
+//
+// --progmem prints games/Flip7Length.h instead of the report: the rounds and seconds per round that Flip7 shows at
+// STARTUP as a game length estimate.
+//
+// It also checks Flip7's maxRoundScore, the clamp on score entry in games/Flip7.h, against the most this deck can
+// score in a round and the most any simulated round did.
+//
+// Games run in parallel on all cores. Each game's cards come from the seed, the player count and the game number
+// alone, so the results don't depend on the thread count.
+
+#include "Flip7Rules.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int firmwareMaxRoundScore = 171; // maxRoundScore in games/Flip7.h.
+const int minTarget = 200;             // minScore and maxScore in games/Flip7.h. The target moves in tens.
+const int maxTarget = 990;
+const int targetStep = 10;
+const int lastTrackedTarget = 1000; // So games/Flip7Length.h can have a column at 1000 to interpolate up to 990.
+const int targetCount = (lastTrackedTarget - minTarget) / targetStep + 1;
+const int lengthTargetStep = 100;   // Columns of games/Flip7Length.h.
+const int shownTargets[] = { 200, 250, 300, 400, 500, 600, 700, 800, 990 };
+const int maxRounds = 400; // A game still going after this many rounds is cut off.
+const int gamesPerJob = 200;
+
+// What a round costs the table in seconds, roughly, from dealr_turntable's baseline with each prompt answered in
+// 2.5 s: DEALR's seek and throw for each card plus the table confirming it, each hit-or-stay answer, and each
+// player's score entry.
+const double cardSeconds = 8.5;
+const double promptSeconds = 2.5;
+const double scoreSeconds = 3.0;
+
+// Counts of small non-negative values. Anything past the end lands in the last bucket.
+struct Histogram {
+    std::vector<long> counts;
+    explicit Histogram(size_t size = 0) : counts(size, 0) {}
+    void add(int value) { counts[std::min<size_t>(std::max(value, 0), counts.size() - 1)]++; }
+    void merge(const Histogram& other) {
+        for (size_t i = 0; i < counts.size(); i++) {
+            counts[i] += other.counts[i];
+        }
+    }
+    long total() const {
+        long n = 0;
+        for (long c : counts) n += c;
+        return n;
+    }
+    double mean() const {
+        long n = 0;
+        double sum = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            n += counts[i];
+            sum += static_cast<double>(i) * counts[i];
+        }
+        return n ? sum / n : 0;
+    }
+    int percentile(double p) const {
+        long n = total();
+        long seen = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen > 0 && seen >= p * n) {
+                return static_cast<int>(i);
+            }
+        }
+        return 0;
+    }
+};
+
+struct Stats {
+    long rounds = 0;
+    long playerRounds = 0;
+    long busts = 0;
+    long flip7s = 0;
+    long freezes = 0;
+    long flipThrees = 0;
+    long cutOff = 0;
+    int highestScore = 0;
+    long overClamp = 0;
+    Histogram cards = Histogram(200);
+    Histogram decisions = Histogram(200);
+    Histogram scores = Histogram(200);
+    std::vector<Histogram> roundsToTarget = std::vector<Histogram>(targetCount, Histogram(maxRounds + 1));
+    std::vector<long> wins; // By strategy in --table.
+    std::vector<long> seats;
+
+    void merge(const Stats& other) {
+        rounds += other.rounds;
+        playerRounds += other.playerRounds;
+        busts += other.busts;
+        flip7s += other.flip7s;
+        freezes += other.freezes;
+        flipThrees += other.flipThrees;
+        cutOff += other.cutOff;
+        highestScore = std::max(highestScore, other.highestScore);
+        overClamp += other.overClamp;
+        cards.merge(other.cards);
+        decisions.merge(other.decisions);
+        scores.merge(other.scores);
+        for (int t = 0; t < targetCount; t++) {
+            roundsToTarget[t].merge(other.roundsToTarget[t]);
+        }
+        for (size_t s = 0; s < wins.size(); s++) {
+            wins[s] += other.wins[s];
+            seats[s] += other.seats[s];
+        }
+    }
+};
+
+void playGame(int players, const std::vector<const Flip7Strategy*>& table, int winTarget, uint32_t seed, int game,
+    Stats& stats) {
+    std::vector<const Flip7Strategy*> seats;
+    std::vector<int> strategyAt;
+    for (int i = 0; i < players; i++) {
+        seats.push_back(table[i % table.size()]);
+        strategyAt.push_back(i % table.size());
+        stats.seats[i % table.size()]++;
+    }
+    std::seed_seq seq = { seed, static_cast<uint32_t>(players), static_cast<uint32_t>(game) };
+    std::mt19937 seeder(seq);
+    Flip7Table flip7(seats, seeder());
+
+    int reached = 0; // Targets the lead has reached so far.
+    bool won = false;
+    int round = 0;
+    while (reached < targetCount && round < maxRounds) {
+        Flip7Round result = flip7.playRound();
+        round++;
+        stats.rounds++;
+        stats.playerRounds += players;
+        stats.busts += result.busts;
+        stats.flip7s += result.flip7 ? 1 : 0;
+        stats.freezes += result.freezes;
+        stats.flipThrees += result.flipThrees;
+        stats.cards.add(result.cards);
+        stats.decisions.add(result.decisions);
+        for (int score : result.scores) {
+            stats.scores.add(score);
+            stats.highestScore = std::max(stats.highestScore, score);
+            stats.overClamp += score > firmwareMaxRoundScore ? 1 : 0;
+        }
+
+        int lead = *std::max_element(flip7.totals().begin(), flip7.totals().end());
+        while (reached < targetCount && lead >= minTarget + reached * targetStep) {
+            stats.roundsToTarget[reached].add(round);
+            reached++;
+        }
+        int winner = flip7.winner(winTarget);
+        if (!won && winner >= 0) {
+            stats.wins[strategyAt[winner]]++;
+            won = true;
+        }
+    }
+    if (reached < targetCount) {
+        stats.cutOff++;
+    }
+}
+
+double roundSeconds(const Stats& stats, int players) {
+    return stats.cards.mean() * cardSeconds + stats.decisions.mean() * promptSeconds + players * scoreSeconds;
+}
+
+// games/Flip7Length.h: expected rounds (in tenths) at every 100 points from 200 to 1000 by player count, and seconds
+// per round.
+void printLengthHeader(const std::vector<Stats>& stats, int games, const std::string& table, uint32_t seed) {
+    const int columns = (lastTrackedTarget - minTarget) / lengthTargetStep + 1;
+    printf("#ifndef FLIP7_LENGTH_H\n#define FLIP7_LENGTH_H\n\n");
+    printf("//\n");
+    printf("//  How long a game of Flip7 lasts, for the estimate on the STARTUP screen. Generated by host/dealr_flip7_odds\n");
+    printf("//  --progmem from %d simulated games per player count (table: %s, seed %u). Rerun it rather than editing this.\n",
+        games, table.c_str(), seed);
+    printf("//\n\n");
+    printf("#include <Arduino.h>\n\n");
+    printf("#define FLIP7_LENGTH_FEWEST_PLAYERS %d\n", 2);
+    printf("#define FLIP7_LENGTH_PLAYER_COUNTS %zu\n", stats.size());
+    printf("#define FLIP7_LENGTH_FIRST_TARGET %d\n", minTarget);
+    printf("#define FLIP7_LENGTH_TARGET_STEP %d\n", lengthTargetStep);
+    printf("#define FLIP7_LENGTH_TARGETS %d\n\n", columns);
+    printf("// Rounds until someone reaches each target, in tenths, by player count.\n");
+    printf("const uint16_t flip7LengthRounds[FLIP7_LENGTH_PLAYER_COUNTS][FLIP7_LENGTH_TARGETS] PROGMEM = {\n");
+    for (size_t c = 0; c < stats.size(); c++) {
+        printf("    {");
+        for (int column = 0; column < columns; column++) {
+            const Histogram& h = stats[c].roundsToTarget[column * lengthTargetStep / targetStep];
+            printf("%s%d", column ? ", " : " ", static_cast<int>(h.mean() * 10 + 0.5));
+        }
+        printf(" }, // %zu players\n", c + 2);
+    }
+    printf("};\n\n");
+    printf("// Seconds per round at the table, by player count.\n");
+    printf("const uint16_t flip7LengthRoundSeconds[FLIP7_LENGTH_PLAYER_COUNTS] PROGMEM = {");
+    for (size_t c = 0; c < stats.size(); c++) {
+        printf("%s%d", c ? ", " : " ", static_cast<int>(roundSeconds(stats[c], c + 2) + 0.5));
+    }
+    printf(" };\n\n#endif // FLIP7_LENGTH_H\n");
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> names;
+    std::stringstream in(list);
+    std::string name;
+    while (std::getline(in, name, ',')) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+}
+
+int main(int argc, char** argv) {
+    int minPlayers = 2;
+    int maxPlayers = 8;
+    int games = 20000;
+    int winTarget = minTarget;
+    int threads = 0;
+    uint32_t seed = 1;
+    std::string tableList = "steady";
+    bool progmem = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--players" && i + 1 < argc) {
+            std::string range = argv[++i];
+            size_t dash = range.find('-');
+            minPlayers = atoi(range.c_str());
+            maxPlayers = dash == std::string::npos ? minPlayers : atoi(range.c_str() + dash + 1);
+        } else if (arg == "--games" && i + 1 < argc) {
+            games = atoi(argv[++i]);
+        } else if (arg == "--table" && i + 1 < argc) {
+            tableList = argv[++i];
+        } else if (arg == "--target" && i + 1 < argc) {
+            winTarget = atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--progmem") {
+            progmem = true;
+        } else {
+            fprintf(stderr, "usage: %s [--players 2-8] [--games n] [--table strategy,...] [--target score] [--threads n] [--seed n] [--progmem]\n",
+                argv[0]);
+            fprintf(stderr, "strategies:");
+            for (const Flip7Strategy& strategy : flip7Strategies()) {
+                fprintf(stderr, " %s", strategy.name);
+            }
+            fprintf(stderr, "\n");
+            return 1;
+        }
+    }
+    if (minPlayers < 2 || maxPlayers > 8 || minPlayers > maxPlayers || games < 1 || winTarget < minTarget || winTarget > maxTarget) {
+        fprintf(stderr, "DEALR seats 2 to 8 players and plays to between %d and %d\n", minTarget, maxTarget);
+        return 1;
+    }
+    if (progmem && (minPlayers != 2 || maxPlayers != 8)) {
+        fprintf(stderr, "--progmem needs every player count from 2 to 8\n");
+        return 1;
+    }
+    std::vector<const Flip7Strategy*> table;
+    for (const std::string& name : split(tableList)) {
+        const Flip7Strategy* strategy = findFlip7Strategy(name);
+        if (!strategy) {
+            fprintf(stderr, "no strategy called %s\n", name.c_str());
+            return 1;
+        }
+        table.push_back(strategy);
+    }
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const int playerCounts = maxPlayers - minPlayers + 1;
+    const int jobsPerCount = (games + gamesPerJob - 1) / gamesPerJob;
+    fprintf(progmem ? stderr : stdout, "Flip7 odds: %d games to %d for each player count, table: %s, %d threads\n", games,
+        lastTrackedTarget, tableList.c_str(), threads);
+
+    // Each thread keeps its own totals, merged at the end. They're all counts, so the merge order doesn't matter.
+    Stats blank;
+    blank.wins.assign(table.size(), 0);
+    blank.seats.assign(table.size(), 0);
+    std::vector<std::vector<Stats>> perThread(threads, std::vector<Stats>(playerCounts, blank));
+    std::atomic<int> next(0);
+    auto work = [&](int t) {
+        for (int job = next++; job < playerCounts * jobsPerCount; job = next++) {
+            int players = minPlayers + job / jobsPerCount;
+            int first = (job % jobsPerCount) * gamesPerJob;
+            for (int game = first; game < std::min(games, first + gamesPerJob); game++) {
+                playGame(players, table, winTarget, seed, game, perThread[t][players - minPlayers]);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back(work, t);
+    }
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    std::vector<Stats> stats(playerCounts, blank);
+    for (int t = 0; t < threads; t++) {
+        for (int c = 0; c < playerCounts; c++) {
+            stats[c].merge(perThread[t][c]);
+        }
+    }
+
+    if (progmem) {
+        printLengthHeader(stats, games, tableList, seed);
+        return 0;
+    }
+
+    long totalRounds = 0;
+    int highest = 0;
+    long overClamp = 0;
+    for (const Stats& s : stats) {
+        totalRounds += s.rounds;
+        highest = std::max(highest, s.highestScore);
+        overClamp += s.overClamp;
+    }
+    printf("%ld rounds\n", totalRounds);
+
+    printf("\nEach round: cards thrown, hit-or-stay prompts, busts and scores\n\n");
+    printf("  players  cards  p10  p50  p90   prompts  p90   bust  flip7  freeze  flip3   score  p90  best   time\n");
+    for (int c = 0; c < playerCounts; c++) {
+        const Stats& s = stats[c];
+        printf("  %7d  %5.1f  %3d  %3d  %3d   %7.1f  %3d  %4.0f%%  %4.1f%%  %6.2f  %5.2f   %5.1f  %3d  %4d  %3.0f s\n",
+            minPlayers + c, s.cards.mean(), s.cards.percentile(0.1), s.cards.percentile(0.5), s.cards.percentile(0.9),
+            s.decisions.mean(), s.decisions.percentile(0.9), 100.0 * s.busts / s.playerRounds,
+            100.0 * s.flip7s / s.rounds, static_cast<double>(s.freezes) / s.rounds,
+            static_cast<double>(s.flipThrees) / s.rounds, s.scores.mean(), s.scores.percentile(0.9), s.highestScore,
+            roundSeconds(s, minPlayers + c));
+    }
+    printf("\n  bust is per player per round, flip7 per round, freeze and flip3 are cards played per round, and score\n"
+           "  is per player per round, busts included. time is a rough guess at the round's length at the table.\n");
+
+    printf("\nRounds until the lead reaches the target (mean, p90)\n\n  players");
+    for (int target : shownTargets) {
+        printf("  %9d", target);
+    }
+    printf("\n");
+    for (int c = 0; c < playerCounts; c++) {
+        printf("  %7d", minPlayers + c);
+        for (int target : shownTargets) {
+            const Histogram& h = stats[c].roundsToTarget[(target - minTarget) / targetStep];
+            printf("  %5.1f %3d", h.mean(), h.percentile(0.9));
+        }
+        printf("\n");
+    }
+
+    printf("\nMinutes for the whole game (mean)\n\n  players");
+    for (int target : shownTargets) {
+        printf("  %9d", target);
+    }
+    printf("\n");
+    for (int c = 0; c < playerCounts; c++) {
+        printf("  %7d", minPlayers + c);
+        for (int target : shownTargets) {
+            const Histogram& h = stats[c].roundsToTarget[(target - minTarget) / targetStep];
+            printf("  %9.0f", h.mean() * roundSeconds(stats[c], minPlayers + c) / 60);
+        }
+        printf("\n");
+    }
+
+    long cutOff = 0;
+    for (const Stats& s : stats) {
+        cutOff += s.cutOff;
+    }
+    if (cutOff > 0) {
+        printf("  %ld games were cut off after %d rounds and count only for the targets they reached.\n", cutOff, maxRounds);
+    }
+
+    if (table.size() > 1) {
+        printf("\nGames to %d won by each seat playing a strategy\n\n  players", winTarget);
+        for (const Flip7Strategy* strategy : table) {
+            printf("  %9s", strategy->name);
+        }
+        printf("\n");
+        for (int c = 0; c < playerCounts; c++) {
+            printf("  %7d", minPlayers + c);
+            for (size_t s = 0; s < table.size(); s++) {
+                printf("  %8.1f%%", stats[c].seats[s] ? 100.0 * stats[c].wins[s] / stats[c].seats[s] : 0.0);
+            }
+            printf("\n");
+        }
+    }
+
+    int deckMax = Flip7Deck().maxRoundScore();
+    printf("\nmaxRoundScore: the firmware clamps round scores at %d. The deck allows %d, and the best simulated round "
+           "scored %d.\n", firmwareMaxRoundScore, deckMax, highest);
+    if (deckMax > firmwareMaxRoundScore || overClamp > 0) {
+        printf("  %ld rounds scored more than the firmware lets a player enter. Raise maxRoundScore to %d.\n", overClamp,
+            deckMax);
+        return 1;
+    }
+    if (deckMax < firmwareMaxRoundScore) {
+        printf("  The clamp is looser than it needs to be. %d would do.\n", deckMax);
+    }
+    return 0;
+}
@@ -0,0 +1,826 @@
+// Walks every state a Flip7 round can reach on DEALR, pressing every button in every state, and reports what the
+// turntable costs: seat-to-seat steps and cards dealt, per press and per round, worst case and on average.
+//
+//     dealr_flip7_paths [--players 2-8] [--flip3-depth 1-4] [--cards n] [--rounds n] [--seed n]
+//
+// games/Flip7.h is compiled here on its own, without the rest of the sketch, against a table model in place of the
+// motors, the colour sensor and the card feeder: seat i has tag i + 1, and each press runs the real handler against
+// it. A game state is everything Flip7Inspector::stateKey() covers (the state, flags, player statuses, the Flip Three
+// return stack) plus where the sensor is and the colour DEALR last read. Scores never change where DEALR goes, so
+// they're left out, and the score digit presses are skipped.
+//
+// A round runs from G on the score screen to the score screen again. spin() turns the table for a fixed time, so it
+// can stop anywhere: a press that spins is tried once for every seat the spin could stop at.
+//
+// Each Flip Three played inside another multiplies the states by the number of seats, so bigger tables are explored
+// with fewer nested: all four (MAX_FLIP3_DEPTH) up to 4 seats, two at 5 and 6, one at 7 and 8, where it's about 15
+// million states, 2 GB and ten minutes on one core. --flip3-depth sets it for every table size.
+//
+// The report for each player count:
+//   - The reachable states and presses, and the worst single press in each state.
+//   - The worst round: the most steps any button sequence can cost, with at most --cards cards dealt (8 for each
+//     player plus 9 by default: the first card and seven hits each, and three Flip Threes). Without a card limit a
+//     round can go on forever, as the cards don't run out in the firmware.
+//   - The average round over --rounds random rounds, with dealr_turntable's odds, and the presses the steps go on.
+//   - Problems, each with the button sequence that gets there: a press that hangs (a CPU loop with nothing left to
+//     find) or turns more than two laps looking for a tag, DEALR stopped at a different seat from the player the game
+//     is prompting or dealing to, states the round can't end from, and loops that turn the table without dealing.
+//
+// Exits 1 if it finds a problem.
+
+#include <Arduino.h>
+#include "games/Flip7.h"
+#include "games/Flip7Inspector.h"
+
+#include <signal.h>
+#include <setjmp.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The sketch's globals and core functions that games/Flip7.h uses, against the table model below.
+dealState currentDealState = IDLE;
+displayState currentDisplayState;
+bool postDeal = false;
+uint8_t remainingRoundsToDeal = 0;
+uint8_t initialRoundsToDeal = 0;
+int8_t postCardsToDeal = 0;
+const char* customFace = nullptr;
+uint8_t messageRepetitions = 0;
+uint8_t activeColor = 0;
+const uint8_t highSpeed = 255;   // As in Flip7DealerMain.ino. Only spin() turns at highSpeed.
+const uint8_t mediumSpeed = 220;
+const uint8_t lowSpeed = 180;
+const uint8_t debounceCount = 3;
+RGBColor colors[TOTAL_COLORS]; // Tuned colours, for the seat decoder's misread costs. The model never misreads.
+uint16_t scrollDelayTime = 0;
+Flags1 flags1;
+Flags2 flags2;
+Flags3 flags3;
+Flags4 flags4;
+
+namespace {
+
+const char* stateNames[] = { "STARTUP", "DEALSPECIAL", "ACTION", "PICK", "PICKSPECIAL", "PICKPLAYER", "ENTERSCORE",
+                             "REPORTSCORE", "SHOWSCORES", "GAMEOVER" };
+const int buttons[] = { Buttons::GREEN, Buttons::RED, Buttons::YELLOW, Buttons::BLUE };
+const char buttonNames[] = "GRYB";
+const int buttonCount = 4;
+const int maxFlip3Depth = 4; // MAX_FLIP3_DEPTH in games/Flip7.h.
+
+// dealr_turntable's odds, for the average round.
+const double hitChance = 0.6;
+const double bustChance = 0.2;
+const double specialChance = 0.08;
+const double sevenChance = 0.01;
+
+// What a press cost the table.
+struct Cost {
+    int steps = 0; // Tag to tag moves.
+    int cards = 0;
+    int spins = 0;
+};
+
+// Where the sensor is. Between tags, it reads black.
+struct Table {
+    uint8_t seat = 0;
+    bool between = false;
+};
+
+struct Node {
+    Flip7 game;
+    Table table;
+    uint8_t activeColor = 0;
+};
+
+// The table during a press.
+int seats = 0;
+Table table;
+bool moving = false;
+bool spinning = false;
+int spinStop = 0; // The seat a spin stops at.
+Cost pressCost;
+std::string pressProblem; // What went wrong, in general.
+std::string pressDetail;  // And where.
+const Flip7* pressing = nullptr;
+
+struct TooManySteps {};
+
+// A press that loops without calling anything here is caught by the timer: if the same press is still running at two
+// ticks in a row, it jumps back out.
+sigjmp_buf hangJump;
+volatile sig_atomic_t inPress = 0;
+volatile unsigned long pressSerial = 0;
+unsigned long serialAtTick = 0;
+
+void onTimer(int) {
+    if (inPress && pressSerial == serialAtTick) {
+        siglongjmp(hangJump, 1);
+    }
+    serialAtTick = pressSerial;
+}
+
+uint8_t seatColor(uint8_t seat) { return seat + 1; }
+
+void noteProblem(const std::string& problem, const std::string& detail = "") {
+    if (pressProblem.empty()) {
+        pressProblem = problem;
+        pressDetail = detail;
+    }
+}
+
+std::string seatName(uint8_t seat) { return "seat " + std::to_string(seat); }
+
+}
+
+void colorScan() {
+    if (!moving) {
+        activeColor = table.between ? 0 : seatColor(table.seat);
+    } else if (!table.between) {
+        table.between = true; // Off the tag.
+        activeColor = 0;
+    } else {
+        table.seat = (table.seat + 1) % seats;
+        table.between = false;
+        activeColor = seatColor(table.seat);
+        if (++pressCost.steps > 2 * seats) {
+            throw TooManySteps();
+        }
+    }
+}
+
+void rotate(uint8_t rotationSpeed, bool) {
+    moving = true;
+    spinning = spinning || rotationSpeed == highSpeed;
+}
+
+void rotateStop() {
+    moving = false;
+    if (spinning) {
+        spinning = false;
+        pressCost.spins++;
+        table.seat = spinStop;
+        table.between = false;
+    }
+}
+
+void moveOffActiveColor(bool rotateClockwise) { // As in Flip7DealerMain.ino.
+    while (activeColor != 0) {
+        colorScan();
+        rotate(lowSpeed, rotateClockwise);
+    }
+    rotateStop();
+}
+
+void dealSingleCard(uint8_t amount) {
+    pressCost.cards += amount;
+    uint8_t player = Flip7Inspector::currentPlayer(*pressing);
+    if (table.between || table.seat != player) {
+        noteProblem("deals to the wrong seat", (table.between ? std::string("between seats") : seatName(table.seat)) +
+                                                   " for player " + std::to_string(player));
+    }
+}
+
+void feedWatchdog() {}
+void reportError(errorCode) {}
+void displayErrorMessage(const char*) { noteProblem("gives up looking for a tag"); }
+void displayFace(const char*) {}
+void updateDisplay() {}
+void startScrollText(const char*, uint16_t, uint16_t, uint16_t) {}
+void updateScrollText() {}
+void stopScrollText() {}
+void saveGameSnapshot(const void*, uint8_t) {}
+bool loadGameSnapshot(void*, uint8_t) { return false; }
+void clearGameSnapshot() {}
+void saveSeatRing(const uint8_t*, uint8_t) {}
+uint8_t loadSeatRing(uint8_t*, uint8_t) { return 0; }
+void clearSeatRing() {}
+void resetRoundStats() {}
+void resetGameStats() {}
+void showRoundStats(bool) {}
+
+namespace {
+
+struct Press {
+    Cost cost;
+    bool spun = false;
+    std::string problem;
+    std::string detail;
+    bool lost = false; // Hung or ran away, so the game's state after it means nothing.
+};
+
+// Presses a button on the game in `node`, which then holds the state after it. A spin stops at `stopSeat`.
+Press press(Node& node, int button, int stopSeat) {
+    table = node.table;
+    spinStop = stopSeat;
+    activeColor = node.activeColor;
+    moving = spinning = false;
+    pressCost = Cost();
+    pressProblem.clear();
+    pressDetail.clear();
+    pressing = &node.game;
+
+    Press result;
+    pressSerial++;
+    if (sigsetjmp(hangJump, 1) == 0) {
+        inPress = 1;
+        try {
+            node.game.handleButtonPress(button);
+        } catch (const TooManySteps&) {
+            noteProblem("turns more than two laps looking for a tag");
+            result.lost = true;
+        }
+        inPress = 0;
+    } else {
+        inPress = 0;
+        noteProblem("hangs");
+        result.lost = true;
+    }
+    result.cost = pressCost;
+    result.spun = pressCost.spins > 0;
+    node.table = table;
+    node.activeColor = activeColor;
+
+    // DEALR should be at the player it's asking about.
+    uint8_t state = Flip7Inspector::state(node.game);
+    bool prompting = state == Flip7::DEALSPECIAL || state == Flip7::ACTION || state == Flip7::PICK ||
+                     state == Flip7::PICKSPECIAL || state == Flip7::PICKPLAYER ||
+                     (state == Flip7::ENTERSCORE && Flip7Inspector::isShowingPlayer(node.game));
+    uint8_t player = Flip7Inspector::currentPlayer(node.game);
+    if (prompting && (table.between || table.seat != player)) {
+        noteProblem("prompts a player DEALR isn't pointing at",
+                    std::string("at ") + (table.between ? "no seat" : seatName(table.seat).c_str()) + " for player " +
+                        std::to_string(player) + " in " + stateNames[state]);
+    }
+    result.problem = pressProblem;
+    result.detail = pressDetail;
+    return result;
+}
+
+// A game state, as Flip7Inspector::stateKey() plus the table.
+struct Key {
+    uint8_t bytes[Flip7Inspector::KEY_SIZE + 3];
+    uint8_t length;
+    bool operator==(const Key& other) const {
+        return length == other.length && memcmp(bytes, other.bytes, length) == 0;
+    }
+};
+
+struct KeyHash {
+    size_t operator()(const Key& key) const {
+        uint64_t hash = 14695981039346656037ull; // FNV-1a
+        for (uint8_t i = 0; i < key.length; i++) {
+            hash = (hash ^ key.bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+};
+
+Key keyOf(const Node& node) {
+    Key key;
+    key.length = Flip7Inspector::stateKey(node.game, key.bytes);
+    key.bytes[key.length++] = node.table.seat;
+    key.bytes[key.length++] = node.table.between;
+    key.bytes[key.length++] = node.activeColor;
+    return key;
+}
+
+bool isRoundOver(const Node& node) {
+    uint8_t state = Flip7Inspector::state(node.game);
+    return state == Flip7::REPORTSCORE || state == Flip7::GAMEOVER;
+}
+
+// Score digits only change the scores.
+bool isScorePress(const Node& node, int button) {
+    return Flip7Inspector::state(node.game) == Flip7::ENTERSCORE && (button == Buttons::YELLOW || button == Buttons::BLUE);
+}
+
+// A Flip Three played from inside `limit` others. Each level has a seat's worth more states than the last.
+bool isTooDeep(const Node& node, int button, int limit) {
+    return Flip7Inspector::state(node.game) == Flip7::PICKPLAYER && button == Buttons::GREEN &&
+           Flip7Inspector::specialCard(node.game) == Flip7::FLIP3 && Flip7Inspector::flip3Depth(node.game) >= limit;
+}
+
+// The start of a round: the score screen, with DEALR at the last seat and the first player to go at seat 0.
+Node roundStart(int players) {
+    Node node;
+    Flip7Inspector::seatPlayers(node.game, players);
+    Flip7Inspector::endRound(node.game, 0, players - 1);
+    node.table.seat = players - 1;
+    node.activeColor = seatColor(players - 1);
+    return node;
+}
+
+struct Edge {
+    int32_t to;
+    uint8_t button; // An index into buttons[].
+    uint8_t cards;
+    uint8_t steps;
+};
+
+// Millions of states for the bigger tables, so only what the report needs is kept for each: the way to it, and the
+// presses out of it. The games themselves are dropped once their presses have been tried.
+struct Graph {
+    std::vector<uint8_t> state;
+    std::vector<int32_t> parent; // Breadth first, for the shortest way to each state.
+    std::vector<uint8_t> parentButton;
+    std::vector<int8_t> spinStop;    // The seat a spin stopped at on the way here, or -1.
+    std::vector<uint32_t> firstEdge; // The presses out of state i are edges[firstEdge[i]] to edges[firstEdge[i + 1]].
+    std::vector<Edge> edges;
+    int root = 0;      // The score screen the round starts from.
+    int roundEnd = -1; // Every round's end is one state, the last.
+
+    size_t size() const { return state.size(); }
+};
+
+struct Problem {
+    std::string what;
+    std::string detail;
+    int node;   // Where it happens
+    int button; // on pressing this (an index into buttons[]), or -1 for the state itself.
+};
+
+// The presses from the round's start to `node`.
+std::string pathTo(const Graph& graph, int node) {
+    std::vector<std::string> steps;
+    while (node != graph.root) {
+        std::string step = std::string(stateNames[graph.state[graph.parent[node]]]) + " " +
+                           buttonNames[graph.parentButton[node]];
+        if (graph.spinStop[node] >= 0) {
+            step += " (spin stops at " + seatName(graph.spinStop[node]) + ")";
+        }
+        steps.push_back(step);
+        node = graph.parent[node];
+    }
+    std::string path;
+    for (auto step = steps.rbegin(); step != steps.rend(); ++step) {
+        path += (path.empty() ? "" : ", ") + *step;
+    }
+    return path;
+}
+
+struct PressStat {
+    int worstSteps = 0;
+    int worstNode = -1;
+    uint8_t worstButton = 0;
+};
+
+Graph explore(int players, int flip3Depth, std::vector<Problem>& problems, std::map<int, PressStat>& worstPress) {
+    Graph graph;
+    std::unordered_map<Key, int32_t, KeyHash> index;
+    std::deque<Node> waiting; // Found but not yet pressed, in the order found.
+    const int32_t roundEnd = -1;
+
+    auto add = [&](const Node& node, int parent, uint8_t button, int spinStop) {
+        if (parent >= 0 && isRoundOver(node)) { // Only the start is on the score screen.
+            return roundEnd;
+        }
+        auto found = index.emplace(keyOf(node), static_cast<int32_t>(graph.size()));
+        if (found.second) {
+            graph.state.push_back(Flip7Inspector::state(node.game));
+            graph.parent.push_back(parent);
+            graph.parentButton.push_back(button);
+            graph.spinStop.push_back(spinStop);
+            waiting.push_back(node);
+        }
+        return found.first->second;
+    };
+    graph.root = add(roundStart(players), -1, 0, -1);
+
+    for (int from = 0; !waiting.empty(); from++) {
+        Node node = waiting.front();
+        waiting.pop_front();
+        graph.firstEdge.push_back(graph.edges.size());
+        for (int b = 0; b < buttonCount; b++) {
+            if (from == graph.root && buttons[b] != Buttons::GREEN) {
+                continue; // The score screen's other buttons don't start a round.
+            }
+            if (isScorePress(node, buttons[b]) || isTooDeep(node, buttons[b], flip3Depth)) {
+                continue;
+            }
+            Node after = node;
+            Press result = press(after, buttons[b], node.table.seat);
+
+            PressStat& stat = worstPress[graph.state[from]];
+            if (result.cost.steps > stat.worstSteps) {
+                stat.worstSteps = result.cost.steps;
+                stat.worstNode = from;
+                stat.worstButton = b;
+            }
+            if (!result.problem.empty()) {
+                problems.push_back({ result.problem, result.detail, from, b });
+            }
+            if (result.lost) {
+                continue; // Nothing after a hang or a runaway is worth following.
+            }
+
+            Edge edge = { 0, static_cast<uint8_t>(b), static_cast<uint8_t>(result.cost.cards),
+                          static_cast<uint8_t>(result.cost.steps) };
+            if (result.spun) {
+                for (int seat = 0; seat < players; seat++) {
+                    Node stopped = node;
+                    Press again = press(stopped, buttons[b], seat);
+                    if (!again.problem.empty() && again.problem != result.problem) {
+                        problems.push_back({ again.problem, again.detail, from, b });
+                    }
+                    if (again.lost) {
+                        continue;
+                    }
+                    edge.steps = again.cost.steps;
+                    edge.to = add(stopped, from, b, seat);
+                    graph.edges.push_back(edge);
+                }
+            } else {
+                edge.to = add(after, from, b, -1);
+                graph.edges.push_back(edge);
+            }
+        }
+    }
+
+    graph.roundEnd = graph.size();
+    graph.state.push_back(Flip7::REPORTSCORE);
+    graph.parent.push_back(-1);
+    graph.parentButton.push_back(0);
+    graph.spinStop.push_back(-1);
+    graph.firstEdge.push_back(graph.edges.size());
+    graph.firstEdge.push_back(graph.edges.size());
+    for (Edge& edge : graph.edges) {
+        if (edge.to == roundEnd) {
+            edge.to = graph.roundEnd;
+        }
+    }
+    return graph;
+}
+
+// States the round can't end from.
+std::vector<int> deadEnds(const Graph& graph) {
+    int n = graph.size();
+    std::vector<uint32_t> firstInto(n + 1, 0), into(graph.edges.size());
+    for (const Edge& edge : graph.edges) {
+        firstInto[edge.to + 1]++;
+    }
+    for (int node = 0; node < n; node++) {
+        firstInto[node + 1] += firstInto[node];
+    }
+    std::vector<uint32_t> filled(firstInto.begin(), firstInto.end() - 1);
+    for (int from = 0; from < n; from++) {
+        for (uint32_t e = graph.firstEdge[from]; e < graph.firstEdge[from + 1]; e++) {
+            into[filled[graph.edges[e].to]++] = from;
+        }
+    }
+    std::vector<bool> canEnd(n, false);
+    std::vector<int> queue = { graph.roundEnd };
+    canEnd[graph.roundEnd] = true;
+    for (size_t i = 0; i < queue.size(); i++) {
+        for (uint32_t e = firstInto[queue[i]]; e < firstInto[queue[i] + 1]; e++) {
+            if (!canEnd[into[e]]) {
+                canEnd[into[e]] = true;
+                queue.push_back(into[e]);
+            }
+        }
+    }
+    std::vector<int> dead;
+    for (int node = 0; node < n; node++) {
+        if (!canEnd[node]) {
+            dead.push_back(node);
+        }
+    }
+    return dead;
+}
+
+// Strongly connected components of the presses that deal no cards, numbered sinks first (Tarjan's order).
+// Returns how many there are.
+int cardlessComponents(const Graph& graph, std::vector<int32_t>& componentOf) {
+    int n = graph.size();
+    std::vector<int32_t> order(n, -1), low(n, 0), stack;
+    std::vector<bool> onStack(n, false);
+    componentOf.assign(n, -1);
+    int counter = 0;
+    int components = 0;
+    struct Frame {
+        int node;
+        uint32_t edge;
+    };
+    std::vector<Frame> frames;
+    for (int start = 0; start < n; start++) {
+        if (order[start] >= 0) {
+            continue;
+        }
+        frames.push_back({ start, graph.firstEdge[start] });
+        order[start] = low[start] = counter++;
+        stack.push_back(start);
+        onStack[start] = true;
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            if (frame.edge < graph.firstEdge[frame.node + 1]) {
+                const Edge& edge = graph.edges[frame.edge++];
+                if (edge.cards > 0) {
+                    continue;
+                }
+                if (order[edge.to] < 0) {
+                    order[edge.to] = low[edge.to] = counter++;
+                    stack.push_back(edge.to);
+                    onStack[edge.to] = true;
+                    frames.push_back({ edge.to, graph.firstEdge[edge.to] });
+                } else if (onStack[edge.to]) {
+                    low[frame.node] = std::min(low[frame.node], order[edge.to]);
+                }
+                continue;
+            }
+            int node = frame.node;
+            frames.pop_back();
+            if (!frames.empty()) {
+                low[frames.back().node] = std::min(low[frames.back().node], low[node]);
+            }
+            if (low[node] == order[node]) {
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    componentOf[member] = components;
+                } while (member != node);
+                components++;
+            }
+        }
+    }
+    return components;
+}
+
+// The most steps a round can take, dealing at most `cardLimit` cards. Returns -1 if a loop can turn the table forever
+// without dealing, with `loopNode` in it.
+long worstRound(const Graph& graph, int cardLimit, int& loopNode) {
+    int n = graph.size();
+    std::vector<int32_t> componentOf;
+    int components = cardlessComponents(graph, componentOf);
+    int maxEdgeCards = 0;
+    for (int from = 0; from < n; from++) {
+        for (uint32_t e = graph.firstEdge[from]; e < graph.firstEdge[from + 1]; e++) {
+            const Edge& edge = graph.edges[e];
+            maxEdgeCards = std::max<int>(maxEdgeCards, edge.cards);
+            if (edge.cards == 0 && edge.steps > 0 && componentOf[edge.to] == componentOf[from]) {
+                loopNode = from;
+                return -1;
+            }
+        }
+    }
+
+    // Each component's states, sinks first.
+    std::vector<uint32_t> firstMember(components + 1, 0), members(n);
+    for (int node = 0; node < n; node++) {
+        firstMember[componentOf[node] + 1]++;
+    }
+    for (int c = 0; c < components; c++) {
+        firstMember[c + 1] += firstMember[c];
+    }
+    std::vector<uint32_t> filled(firstMember.begin(), firstMember.end() - 1);
+    for (int node = 0; node < n; node++) {
+        members[filled[componentOf[node]]++] = node;
+    }
+
+    // worst[c % levels][node]: the most steps to the round's end from `node` with c cards left. -1 if it can't end.
+    int levels = maxEdgeCards + 1;
+    std::vector<std::vector<int32_t>> worst(levels, std::vector<int32_t>(n, -1));
+    for (int cards = 0; cards <= cardLimit; cards++) {
+        std::vector<int32_t>& level = worst[cards % levels];
+        for (int c = 0; c < components; c++) {
+            int32_t best = -1;
+            for (uint32_t m = firstMember[c]; m < firstMember[c + 1]; m++) {
+                int node = members[m];
+                if (node == graph.roundEnd) {
+                    best = std::max(best, 0);
+                }
+                for (uint32_t e = graph.firstEdge[node]; e < graph.firstEdge[node + 1]; e++) {
+                    const Edge& edge = graph.edges[e];
+                    if (edge.cards > cards || (edge.cards == 0 && componentOf[edge.to] == c)) {
+                        continue;
+                    }
+                    int32_t after = edge.cards == 0 ? level[edge.to] : worst[(cards - edge.cards) % levels][edge.to];
+                    if (after >= 0) {
+                        best = std::max(best, after + edge.steps);
+                    }
+                }
+            }
+            for (uint32_t m = firstMember[c]; m < firstMember[c + 1]; m++) {
+                level[members[m]] = best;
+            }
+        }
+    }
+    return worst[cardLimit % levels][graph.root];
+}
+
+struct Average {
+    double steps = 0;
+    double cards = 0;
+    double spins = 0;
+    std::map<std::string, double> stepsByPress; // "STATE button -> STATE"
+};
+
+// Plays random rounds with dealr_turntable's odds. A special card goes to a random active player.
+Average averageRound(int players, int rounds, uint32_t seed) {
+    std::mt19937 rng(seed * 9 + players);
+    std::uniform_real_distribution<double> chance(0, 1);
+    Average average;
+    for (int round = 0; round < rounds; round++) {
+        Node node = roundStart(players);
+        int button = Buttons::GREEN;
+        int picks = -1;            // PICKPLAYER presses still to make.
+        bool specialChosen = false;
+        for (int presses = 0; presses < 100000; presses++) {
+            uint8_t from = Flip7Inspector::state(node.game);
+            Press result = press(node, button, std::uniform_int_distribution<int>(0, players - 1)(rng));
+            uint8_t to = Flip7Inspector::state(node.game);
+            average.steps += result.cost.steps;
+            average.cards += result.cost.cards;
+            average.spins += result.cost.spins;
+            if (result.cost.steps > 0) {
+                std::string label = std::string(stateNames[from]) + " " +
+                                    buttonNames[std::find(buttons, buttons + buttonCount, button) - buttons] + " -> " +
+                                    stateNames[to];
+                average.stepsByPress[label] += result.cost.steps;
+            }
+            if (isRoundOver(node) && presses > 0) {
+                break;
+            }
+
+            double r = chance(rng);
+            if (to != Flip7::PICKSPECIAL) {
+                specialChosen = false;
+            }
+            if (to != Flip7::PICKPLAYER) {
+                picks = -1;
+            }
+            switch (to) {
+                case Flip7::DEALSPECIAL:
+                    button = r < specialChance ? Buttons::RED : Buttons::GREEN;
+                    break;
+                case Flip7::ACTION:
+                    button = r < hitChance ? Buttons::RED : Buttons::GREEN;
+                    break;
+                case Flip7::PICK:
+                    if (r < bustChance) {
+                        button = Buttons::RED;
+                    } else if (r < bustChance + specialChance) {
+                        button = Buttons::YELLOW;
+                    } else if (r < bustChance + specialChance + sevenChance) {
+                        button = Buttons::BLUE;
+                    } else {
+                        button = Buttons::GREEN;
+                    }
+                    break;
+                case Flip7::PICKSPECIAL:
+                    button = specialChosen ? Buttons::GREEN : (r < 0.5 ? Buttons::YELLOW : Buttons::BLUE);
+                    specialChosen = true;
+                    break;
+                case Flip7::PICKPLAYER:
+                    if (picks < 0) {
+                        picks = std::uniform_int_distribution<int>(1, players)(rng);
+                    }
+                    button = picks-- > 0 ? Buttons::BLUE : Buttons::GREEN;
+                    break;
+                default:
+                    button = Buttons::GREEN;
+                    break;
+            }
+        }
+    }
+    average.steps /= rounds;
+    average.cards /= rounds;
+    average.spins /= rounds;
+    for (auto& entry : average.stepsByPress) {
+        entry.second /= rounds;
+    }
+    return average;
+}
+
+}
+
+int main(int argc, char** argv) {
+    int minPlayers = 2;
+    int maxPlayers = 8;
+    int cardLimit = -1;
+    int rounds = 20000;
+    int flip3Depth = 0; // By table size.
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--players" && i + 1 < argc) {
+            std::string range = argv[++i];
+            size_t dash = range.find('-');
+            minPlayers = atoi(range.c_str());
+            maxPlayers = dash == std::string::npos ? minPlayers : atoi(range.c_str() + dash + 1);
+        } else if (arg == "--cards" && i + 1 < argc) {
+            cardLimit = atoi(argv[++i]);
+        } else if (arg == "--flip3-depth" && i + 1 < argc) {
+            flip3Depth = atoi(argv[++i]);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            rounds = atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--players 2-8] [--flip3-depth 1-4] [--cards n] [--rounds n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (minPlayers < 2 || maxPlayers > MAX_PLAYERS || minPlayers > maxPlayers || rounds < 1) {
+        fprintf(stderr, "DEALR seats 2 to %d players\n", MAX_PLAYERS);
+        return 1;
+    }
+    if (flip3Depth < 0 || flip3Depth > maxFlip3Depth) {
+        fprintf(stderr, "Flip Threes nest %d deep at most\n", maxFlip3Depth);
+        return 1;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler = onTimer;
+    sigaction(SIGALRM, &action, nullptr);
+    struct itimerval timer = { { 1, 0 }, { 1, 0 } };
+    setitimer(ITIMER_REAL, &timer, nullptr);
+
+    bool anyProblem = false;
+    for (int players = minPlayers; players <= maxPlayers; players++) {
+        seats = players;
+        int limit = cardLimit >= 0 ? cardLimit : 8 * players + 9;
+        std::vector<Problem> problems;
+        std::map<int, PressStat> worstPress;
+        int depth = flip3Depth ? flip3Depth : (players <= 4 ? maxFlip3Depth : players <= 6 ? 2 : 1);
+        Graph graph = explore(players, depth, problems, worstPress);
+        printf("%d players: %zu states, %zu moves between them, Flip Threes up to %d deep\n", players, graph.size() - 1,
+               graph.edges.size(), depth);
+
+        printf("  worst press in each state:\n");
+        for (const auto& entry : worstPress) {
+            const PressStat& stat = entry.second;
+            printf("    %-12s %2d steps", stateNames[entry.first], stat.worstSteps);
+            if (stat.worstNode >= 0 && stat.worstSteps > 0) {
+                std::string path = pathTo(graph, stat.worstNode);
+                printf("  %s%s%c", path.c_str(), path.empty() ? "" : ", ", buttonNames[stat.worstButton]);
+            }
+            printf("\n");
+        }
+
+        int loopNode = -1;
+        long worst = worstRound(graph, limit, loopNode);
+        if (worst < 0 && loopNode >= 0) {
+            problems.push_back({ "can turn the table forever without dealing", "", loopNode, -1 });
+        } else {
+            printf("  worst round with up to %d cards: %ld steps (%.1f laps)\n", limit, worst,
+                   static_cast<double>(worst) / players);
+        }
+
+        Average average = averageRound(players, rounds, seed);
+        printf("  average round: %.1f steps (%.2f laps), %.1f cards, %.2f per card, %.2f spins\n", average.steps,
+               average.steps / players, average.cards, average.cards > 0 ? average.steps / average.cards : 0,
+               average.spins);
+        std::vector<std::pair<double, std::string>> shares;
+        for (const auto& entry : average.stepsByPress) {
+            shares.push_back({ entry.second, entry.first });
+        }
+        std::sort(shares.rbegin(), shares.rend());
+        for (const auto& share : shares) {
+            if (share.first / average.steps < 0.01) {
+                break;
+            }
+            printf("    %5.1f%%  %5.2f steps  %s\n", 100 * share.first / average.steps, share.first,
+                   share.second.c_str());
+        }
+
+        for (int node : deadEnds(graph)) {
+            problems.push_back({ "the round can't end", "", node, -1 });
+        }
+        if (!problems.empty()) {
+            anyProblem = true;
+            std::map<std::string, std::pair<int, const Problem*>> kinds; // Counted, with the shortest example.
+            for (const Problem& problem : problems) {
+                auto& entry = kinds[problem.what];
+                entry.first++;
+                if (!entry.second) {
+                    entry.second = &problem;
+                }
+            }
+            printf("  problems:\n");
+            for (const auto& entry : kinds) {
+                const Problem& example = *entry.second.second;
+                std::string path = pathTo(graph, example.node);
+                if (example.button >= 0) {
+                    path += (path.empty() ? "" : ", ") +
+                            std::string(stateNames[graph.state[example.node]]) + " " +
+                            buttonNames[example.button];
+                }
+                printf("    %s (%d ways), e.g. %s%s%s\n", entry.first.c_str(), entry.second.first,
+                       example.detail.c_str(), example.detail.empty() ? "" : " after ", path.c_str());
+            }
+        }
+        printf("\n");
+    }
+    return anyProblem ? 1 : 0;
+}
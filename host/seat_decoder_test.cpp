@@ -0,0 +1,162 @@
+// Unit tests for SeatDecoder.h, the decoder Flip7 uses to tell which seat DEALR has stepped to from the order of the
+// tags. It's pure logic, so it's compiled here on its own with the default tuned colours:
+//
+//     dealr_seat_decoder_test
+//
+// Each case starts from a known seat on a ring of RED YELO LBLU GREE WHIT PINK, steps or rechecks with a reading, and
+// checks the decoded seat and how sure the decoder is. White and pink are the two default colours that are nearly the
+// same, so a white tag read as pink is the misread the decoder should put right. Prints each failed check and exits 1
+// if there are any.
+
+#include <Arduino.h>
+#include "SeatDecoder.h"
+
+#include <cstdio>
+#include <cstring>
+
+RGBColor colors[TOTAL_COLORS];
+
+namespace {
+
+const uint8_t ring[] = { 1, 2, 3, 4, 5, 6 }; // RED YELO LBLU GREE WHIT PINK, clockwise.
+const uint8_t ringSeats = sizeof(ring);
+int failures = 0;
+
+void check(bool ok, const char* what, int line) {
+    if (!ok) {
+        printf("FAIL line %d: %s\n", line, what);
+        failures++;
+    }
+}
+
+#define CHECK(expr) check((expr), #expr, __LINE__)
+
+bool sure(const SeatDecoder& d) { return d.confidence(d.seat()) >= seatSureMargin; }
+
+void stepsToTheNextSeat() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 0);
+    CHECK(d.nextColor() == 2);
+    d.step(2);
+    CHECK(d.seat() == 1);
+    CHECK(sure(d));
+    CHECK(d.seatColor() == 2);
+    for (uint8_t i = 2; i < ringSeats; i++) {
+        d.step(ring[i]);
+    }
+    d.step(1); // Round to red again.
+    CHECK(d.seat() == 0);
+    CHECK(sure(d));
+}
+
+void passesATagWithoutReadingIt() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 0);
+    d.step(3); // Light blue: yellow went by unread.
+    CHECK(d.seat() == 2);
+    CHECK(sure(d));
+}
+
+void staysOnTheSameTag() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 1);
+    d.step(2); // Still yellow: DEALR didn't get off the tag.
+    CHECK(d.seat() == 1);
+    CHECK(sure(d));
+}
+
+void correctsANearMisread() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 3);
+    d.step(6); // Pink at the white tag.
+    CHECK(d.seat() == 4);
+    CHECK(d.seatColor() == 5); // Not what was read, so Flip7 has a second look.
+    CHECK(sure(d));
+    d.recheck(5); // The second look reads white.
+    CHECK(d.seat() == 4);
+    CHECK(sure(d));
+}
+
+void followsARingWithATagMissing() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 3);
+    d.step(6); // White has gone, so pink is next. It could be a misread white, so white is still the likeliest.
+    d.recheck(6);
+    CHECK(d.seat() == 4);
+    d.step(1); // Red straight after: white's tag isn't there.
+    CHECK(d.seat() == 0);
+}
+
+void blackSaysNothing() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 0);
+    d.step(0);
+    CHECK(d.seat() == 1); // A plain step is still the likeliest move.
+    CHECK(d.confidence(1) == seatSkipCost);
+}
+
+void relocatesAfterASpin() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 0);
+    d.relocate(4);
+    CHECK(d.seat() == 3);
+    CHECK(sure(d));
+    d.relocate(6); // Pink, and white is nearly the same.
+    CHECK(d.seat() == 5);
+    CHECK(!sure(d));
+    d.relocate(0); // Between tags: nothing to go on.
+    CHECK(d.confidence(d.seat()) == 0);
+}
+
+void startsAnywhere() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, SEAT_UNKNOWN);
+    CHECK(d.confidence(d.seat()) == 0);
+    d.step(3);
+    CHECK(d.seat() == 2);
+    CHECK(sure(d));
+}
+
+void clampsTheSeatCount() {
+    uint8_t big[20];
+    for (uint8_t i = 0; i < sizeof(big); i++) {
+        big[i] = i % NUM_PLAYER_COLORS + 1;
+    }
+    SeatDecoder d;
+    d.reset(big, sizeof(big), 0);
+    CHECK(d.isActive());
+    for (uint8_t i = 1; i <= NUM_PLAYER_COLORS; i++) {
+        d.step(big[i % NUM_PLAYER_COLORS]);
+        CHECK(d.seat() < NUM_PLAYER_COLORS);
+    }
+    CHECK(d.seat() == 0); // Round the clamped ring and back to the start.
+}
+
+void followsNothingWhenCleared() {
+    SeatDecoder d;
+    d.reset(ring, ringSeats, 0);
+    d.clear();
+    CHECK(!d.isActive());
+    CHECK(d.nextColor() == 0);
+    CHECK(d.seatColor() == 0);
+    d.step(2);
+    CHECK(!d.isActive());
+}
+
+}
+
+int main() {
+    memcpy_P(colors, defaultColors, sizeof(colors));
+    stepsToTheNextSeat();
+    passesATagWithoutReadingIt();
+    staysOnTheSameTag();
+    correctsANearMisread();
+    followsARingWithATagMissing();
+    blackSaysNothing();
+    relocatesAfterASpin();
+    startsAnywhere();
+    clampsTheSeatCount();
+    followsNothingWhenCleared();
+    printf("%s, %d failed checks\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
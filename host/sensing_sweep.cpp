@@ -0,0 +1,474 @@
+// Sweeps the constants that trade tag-reading speed against accuracy, and prints the Pareto frontier of time per tag
+// against misread rate for each tag layout.
+//
+//     dealr_sensing_sweep [--trials n] [--threads n] [--seed n]
+//
+// Swept, with the sketch's current values marked. They're read from the firmware build (FirmwareProbe.h), and added to
+// the grid if it doesn't have them:
+//     integration time    sensor.setIntegrationTime() in setup()
+//     debounceCount       readings that must agree before activeColor changes
+//     spike threshold     the 1.6x over the black baseline in checkForColorSpike()
+//     highSpeed, mediumSpeed, lowSpeed
+//     numSamples          readings averaged when the colour tuner and black baseline are recorded
+//
+// These are compile-time constants in the sketch, so the sweep doesn't run the firmware. It replays colorRead() and
+// checkForColorSpike() with the constants as parameters, on sensor samples synthesised from the Turntable model's
+// motor, tag and noise settings (Turntable.h). Each reading averages the tag coverage across its integration window,
+// so fast passes see blended edge colours, and shorter integration times see proportionally more noise.
+//
+// Every trial times two traversals from a settled tag to the next seat:
+//     step   Flip7's advanceOnePosition(): off the tag at lowSpeed, then mediumSpeed until a colour settles.
+//     seek   The deal engine: off the tag, highSpeed until a brightness spike, then fineAdjustCheck() backs up at
+//            lowSpeed until a colour settles.
+// A misread is any traversal that ends on the wrong colour, off the tag, or not at all within errorTimeout.
+//
+// Settings run in parallel on all cores. Each trial's start position and noise come from the trial number alone, so
+// every setting sees the same conditions and the results don't depend on the thread count.
+
+#include "HostBoard.h"
+#include "FirmwareProbe.h"
+#include "Turntable.h"
+
+#include <Arduino.h>
+#include "ColorNames.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Settings {
+    uint8_t integration; // 0x0-0x3, as setIntegrationTime() takes it.
+    uint8_t debounce;
+    float spike;
+    uint8_t high;
+    uint8_t medium;
+    uint8_t low;
+    uint8_t samples;
+};
+
+const uint8_t integrationValues[] = { 0x0, 0x1, 0x2 };
+const uint8_t debounceValues[] = { 2, 3, 4, 5 };
+const float spikeValues[] = { 1.3f, 1.6f, 2.0f, 2.5f };
+const uint8_t highValues[] = { 230, 255 };
+const uint8_t mediumValues[] = { 200, 220, 240, 255 };
+const uint8_t lowValues[] = { 170, 180, 200 };
+const uint8_t sampleValues[] = { 1, 3, 10 };
+
+const double integrationMs[] = { 2.0, 8.0, 33.0, 132.0 };
+const double busMs = 0.6;          // Reading the four channels over I2C.
+const double settleDelayMs = 10;   // colorRead()'s delay(10) once a colour is confirmed.
+const double stopDelayMs = 20;     // rotateStop()'s delay(20).
+const double reverseDelayMs = 100; // handleRotationAdjustments() waits this long before backing up.
+const double errorTimeoutMs = 6000;
+const int settleScans = 15;        // advanceOnePosition() scans this many times once stopped.
+const int windowSamples = 3;       // Points across an integration window where the tag coverage is sampled.
+const uint8_t maxDebounce = 8;
+
+struct Layout {
+    const char* name;
+    std::vector<uint8_t> colors; // Seat tag colours in table order. Above 4 are the wider printed tags.
+};
+
+const Layout layouts[] = {
+    { "4 seats", { 1, 2, 3, 4 } },
+    { "6 seats (2 printed tags)", { 1, 2, 3, 4, 5, 6 } },
+    { "8 seats (4 printed tags)", { 1, 2, 3, 4, 5, 6, 7, 8 } },
+};
+
+struct Outcome {
+    double ms = 0;
+    int misreads = 0;
+    int traversals = 0;
+};
+
+// One trial's table and sensor, with the sketch's sensing state for the settings being tried.
+class Trial {
+  public:
+    Trial(const TurntableConfig& model, const Layout& layout, const Settings& s, uint32_t seed)
+        : model(model), layout(layout), s(s), rng(seed) {
+        calibrate();
+    }
+
+    // Starts settled on a random seat, a little off its centre, as a previous traversal would leave it.
+    int settleOnRandomSeat() {
+        int seats = static_cast<int>(layout.colors.size());
+        int seat = std::uniform_int_distribution<int>(0, seats - 1)(rng);
+        angle = seat * 360.0 / seats + std::uniform_real_distribution<double>(-2.0, 2.0)(rng);
+        speed = 0;
+        drivePwm = 0;
+        activeColor = layout.colors[seat];
+        std::fill(buffer, buffer + maxDebounce, activeColor);
+        stableCount = s.debounce;
+        baselineExceeded = true;
+        adjustInProgress = false;
+        return seat;
+    }
+
+    // advanceOnePosition(), including moveOffActiveColor(CW). Returns false on a misread.
+    bool step(int fromSeat, double& ms) {
+        double start = now;
+        if (!moveOff(start)) {
+            ms = now - start;
+            return false;
+        }
+        drive(s.medium, +1);
+        while (activeColor == 0) {
+            if (now - start > errorTimeoutMs) {
+                ms = now - start;
+                return false;
+            }
+            scan();
+        }
+        wait(activeColor > 4 ? 85 : 10); // Past the edge, towards the middle of the tag.
+        stop();
+        for (int i = 0; i < settleScans; i++) {
+            scan();
+        }
+        ms = now - start;
+        return landedOn(fromSeat + 1);
+    }
+
+    // handleAdvancingState() from a settled tag, then fineAdjustCheck(). Returns false on a misread.
+    bool seek(int fromSeat, double& ms) {
+        double start = now;
+        if (!moveOff(start)) {
+            ms = now - start;
+            return false;
+        }
+        drive(s.high, +1);
+        while (!baselineExceeded) {
+            if (now - start > errorTimeoutMs) {
+                ms = now - start;
+                return false;
+            }
+            scan();
+        }
+        adjustInProgress = true;
+        double adjustStart = now;
+        drive(s.low, +1);
+        bool reversed = false;
+        while (activeColor < 1) {
+            scan();
+            if (!reversed) {
+                stop();
+                wait(reverseDelayMs);
+                drive(s.low, -1);
+                reversed = true;
+            }
+            if (now - adjustStart > errorTimeoutMs) {
+                ms = now - start;
+                return false;
+            }
+        }
+        stop();
+        adjustInProgress = false;
+        ms = now - start;
+        return landedOn(fromSeat + 1);
+    }
+
+  private:
+    bool moveOff(double start) {
+        while (activeColor != 0) {
+            if (now - start > errorTimeoutMs) {
+                return false;
+            }
+            scan();
+            drive(s.low, +1);
+        }
+        stop();
+        return true;
+    }
+
+    bool landedOn(int seat) const {
+        int seats = static_cast<int>(layout.colors.size());
+        seat = ((seat % seats) + seats) % seats;
+        return activeColor == layout.colors[seat] && coverage(angle) > 0.5 && tagAt(angle) == seat;
+    }
+
+    void drive(uint8_t pwm, int direction) {
+        drivePwm = pwm;
+        driveDirection = direction;
+    }
+
+    void stop() {
+        drivePwm = 0;
+        wait(stopDelayMs);
+    }
+
+    void wait(double ms) {
+        // Same first-order motor as Turntable, stepped finely enough for the tag edges.
+        const double dt = 0.5;
+        for (double t = 0; t < ms; t += dt) {
+            double target = 0;
+            if (drivePwm > model.stallPwm) {
+                target = driveDirection * model.fullSpeedDegPerSec * (drivePwm - model.stallPwm) / (255.0 - model.stallPwm);
+            }
+            double lag = drivePwm ? model.spinUpMs : model.coastMs;
+            double next = speed + (target - speed) * (1.0 - std::exp(-dt / lag));
+            angle += (speed + next) / 2.0 * dt / 1000.0;
+            speed = next;
+        }
+        now += ms;
+    }
+
+    int tagAt(double a) const {
+        int seats = static_cast<int>(layout.colors.size());
+        double spacing = 360.0 / seats;
+        a = std::fmod(std::fmod(a, 360.0) + 360.0, 360.0);
+        return static_cast<int>(std::floor(a / spacing + 0.5)) % seats;
+    }
+
+    // How much of the sensor's spot is over the nearest tag, with about a degree of soft edge.
+    double coverage(double a) const {
+        int seats = static_cast<int>(layout.colors.size());
+        int seat = tagAt(a);
+        double spacing = 360.0 / seats;
+        a = std::fmod(std::fmod(a, 360.0) + 360.0, 360.0);
+        double offset = std::fabs(a - seat * spacing);
+        offset = std::fmin(offset, 360.0 - offset);
+        double half = (layout.colors[seat] > 4 ? model.wideTagWidthDeg : model.tagWidthDeg) / 2;
+        return std::clamp(half - offset + 0.5, 0.0, 1.0);
+    }
+
+    // One raw reading over the integration window, with the table moving through it.
+    void read(double& r, double& g, double& b, double& c) {
+        double window = integrationMs[s.integration];
+        double scale = window / integrationMs[0x1]; // The model's counts are for the sketch's 8 ms.
+        double sum[4] = { 0, 0, 0, 0 };
+        double startAngle = angle;
+        wait(window + busMs);
+        for (int i = 0; i < windowSamples; i++) {
+            double a = startAngle + (angle - startAngle) * (i + 0.5) / windowSamples;
+            double cover = coverage(a);
+            const RGBColor& tag = defaultColors[layout.colors[tagAt(a)]];
+            const RGBColor& black = defaultColors[0];
+            sum[0] += cover * tag.r * model.tagGain + (1 - cover) * black.r;
+            sum[1] += cover * tag.g * model.tagGain + (1 - cover) * black.g;
+            sum[2] += cover * tag.b * model.tagGain + (1 - cover) * black.b;
+            sum[3] += cover * tag.avgC * model.tagGain + (1 - cover) * black.avgC;
+        }
+        double sigma = model.noiseCounts * std::sqrt(scale);
+        double clearSigma = model.clearNoiseCounts * std::sqrt(scale);
+        r = std::max(0.0, sum[0] / windowSamples * scale + noise(rng) * sigma);
+        g = std::max(0.0, sum[1] / windowSamples * scale + noise(rng) * sigma);
+        b = std::max(0.0, sum[2] / windowSamples * scale + noise(rng) * sigma);
+        c = std::max(0.0, sum[3] / windowSamples * scale + noise(rng) * clearSigma);
+    }
+
+    // The colour tuner and logBlackBaseline(): numSamples readings at rest on each tag, averaged and normalised.
+    void calibrate() {
+        for (int color = 0; color < TOTAL_COLORS; color++) {
+            const RGBColor& base = defaultColors[color];
+            double gain = color == 0 ? 1.0 : model.tagGain;
+            double scale = integrationMs[s.integration] / integrationMs[0x1];
+            double sigma = model.noiseCounts * std::sqrt(scale);
+            double clearSigma = model.clearNoiseCounts * std::sqrt(scale);
+            double r = 0, g = 0, b = 0, c = 0;
+            for (int i = 0; i < s.samples; i++) {
+                r += base.r * gain * scale + noise(rng) * sigma;
+                g += base.g * gain * scale + noise(rng) * sigma;
+                b += base.b * gain * scale + noise(rng) * sigma;
+                c += base.avgC * gain * scale + noise(rng) * clearSigma;
+            }
+            double total = r + g + b;
+            tuned[color][0] = r / total * 255;
+            tuned[color][1] = g / total * 255;
+            tuned[color][2] = b / total * 255;
+            if (color == 0) {
+                blackBaseline = std::min(c / s.samples, 255.0); // Clipped to a byte, as logBlackBaseline() does.
+            }
+        }
+    }
+
+    // colorScan(): checkForColorSpike() and colorRead()'s nearest colour and debounce.
+    void scan() {
+        double r, g, b, c;
+        read(r, g, b, c);
+        if (!baselineExceeded && !adjustInProgress && c >= blackBaseline * s.spike) {
+            baselineExceeded = true;
+        } else if (baselineExceeded && c < blackBaseline * s.spike) {
+            baselineExceeded = false;
+        }
+
+        double total = r + g + b;
+        double nr = r / total * 255, ng = g / total * 255, nb = b / total * 255;
+        uint8_t closest = 0;
+        double best = 1e30;
+        for (int i = 0; i < TOTAL_COLORS; i++) {
+            double d = (nr - tuned[i][0]) * (nr - tuned[i][0]) + (ng - tuned[i][1]) * (ng - tuned[i][1]) +
+                (nb - tuned[i][2]) * (nb - tuned[i][2]);
+            if (d < best) {
+                best = d;
+                closest = i;
+            }
+        }
+        buffer[bufferIndex] = closest;
+        bufferIndex = (bufferIndex + 1) % s.debounce;
+        bool stable = true;
+        for (uint8_t i = 0; i < s.debounce; i++) {
+            stable = stable && buffer[i] == closest;
+        }
+        stableCount = stable ? stableCount + 1 : 0;
+        if (stableCount >= s.debounce) {
+            activeColor = closest;
+            wait(settleDelayMs);
+        }
+    }
+
+    const TurntableConfig& model;
+    const Layout& layout;
+    Settings s;
+    std::mt19937 rng;
+    std::normal_distribution<double> noise{ 0.0, 1.0 };
+
+    double now = 0;
+    double angle = 0;
+    double speed = 0;
+    uint8_t drivePwm = 0;
+    int driveDirection = 1;
+
+    double tuned[TOTAL_COLORS][3];
+    double blackBaseline = 0;
+    uint8_t buffer[maxDebounce] = { 0 };
+    uint8_t bufferIndex = 0;
+    uint16_t stableCount = 0;
+    uint8_t activeColor = 0;
+    bool baselineExceeded = false;
+    bool adjustInProgress = false;
+};
+
+Outcome evaluate(const TurntableConfig& model, const Layout& layout, const Settings& s, int trials, uint32_t seed) {
+    Outcome outcome;
+    for (int t = 0; t < trials; t++) {
+        Trial trial(model, layout, s, seed * 7919 + t);
+        double ms;
+        int seat = trial.settleOnRandomSeat();
+        outcome.misreads += trial.step(seat, ms) ? 0 : 1;
+        outcome.ms += ms;
+        seat = trial.settleOnRandomSeat();
+        outcome.misreads += trial.seek(seat, ms) ? 0 : 1;
+        outcome.ms += ms;
+        outcome.traversals += 2;
+    }
+    return outcome;
+}
+
+// The integration time is only set in setup(), so the firmware boots once on a bare table to give it.
+Settings sketchSettings() {
+    HostBoard::reset();
+    setup();
+    return { FirmwareProbe::integrationTime(), FirmwareProbe::debounceCount(), FirmwareProbe::spikeThreshold(),
+        FirmwareProbe::highSpeed(), FirmwareProbe::mediumSpeed(), FirmwareProbe::lowSpeed(),
+        FirmwareProbe::numSamples() };
+}
+
+bool same(const Settings& a, const Settings& b) {
+    return a.integration == b.integration && a.debounce == b.debounce && a.spike == b.spike && a.high == b.high &&
+        a.medium == b.medium && a.low == b.low && a.samples == b.samples;
+}
+
+void printRow(const Settings& s, const Outcome& o, bool marked) {
+    printf("  %7.2f s  %6.1f%%  %5.0f ms  %8u  %5.1fx  %4u  %4u  %4u  %7u%s\n", o.ms / o.traversals / 1000.0,
+        100.0 * o.misreads / o.traversals, integrationMs[s.integration], s.debounce, s.spike, s.high, s.medium, s.low,
+        s.samples, marked ? "  <- sketch" : "");
+}
+
+}
+
+int main(int argc, char** argv) {
+    int trials = 60;
+    int threads = 0;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--trials" && i + 1 < argc) {
+            trials = atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--trials n] [--threads n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<Settings> grid;
+    for (uint8_t integration : integrationValues)
+        for (uint8_t debounce : debounceValues)
+            for (float spike : spikeValues)
+                for (uint8_t high : highValues)
+                    for (uint8_t medium : mediumValues)
+                        for (uint8_t low : lowValues)
+                            for (uint8_t samples : sampleValues)
+                                grid.push_back({ integration, debounce, spike, high, medium, low, samples });
+    const Settings current = sketchSettings();
+    if (std::none_of(grid.begin(), grid.end(), [&](const Settings& s) { return same(s, current); })) {
+        grid.push_back(current);
+    }
+
+    const TurntableConfig model;
+    const int layoutCount = sizeof(layouts) / sizeof(layouts[0]);
+    printf("Sensing sweep: %zu settings, %d layouts, %d trials each (a step and a seek per trial), %d threads\n",
+        grid.size(), layoutCount, trials, threads);
+
+    std::vector<Outcome> results(grid.size() * layoutCount);
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+        for (size_t i = next++; i < results.size(); i = next++) {
+            const Layout& layout = layouts[i / grid.size()];
+            results[i] = evaluate(model, layout, grid[i % grid.size()], trials, seed);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back(work);
+    }
+    for (std::thread& t : pool) {
+        t.join();
+    }
+
+    for (int l = 0; l < layoutCount; l++) {
+        std::vector<size_t> order(grid.size());
+        for (size_t i = 0; i < grid.size(); i++) {
+            order[i] = l * grid.size() + i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (results[a].ms != results[b].ms) return results[a].ms < results[b].ms;
+            return results[a].misreads < results[b].misreads;
+        });
+
+        printf("\n%s: Pareto frontier, time per tag against misreads\n\n", layouts[l].name);
+        printf("  time/tag  misread    integ  debounce  spike  high   med   low  samples\n");
+        int fewest = 1 << 30;
+        bool sketchShown = false;
+        for (size_t i : order) {
+            if (results[i].misreads >= fewest) {
+                continue;
+            }
+            fewest = results[i].misreads;
+            bool isSketch = same(grid[i % grid.size()], current);
+            sketchShown = sketchShown || isSketch;
+            printRow(grid[i % grid.size()], results[i], isSketch);
+        }
+        if (!sketchShown) {
+            for (size_t i : order) {
+                if (same(grid[i % grid.size()], current)) {
+                    printf("  not on the frontier:\n");
+                    printRow(current, results[i], true);
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,5 @@
+// Host stand-in: the DEALR firmware only needs the LED backpack, which does not use GFX.
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+#include <Arduino.h>
+#endif // HOST_ADAFRUIT_GFX_H
@@ -0,0 +1,26 @@
+// Host stand-in for the 14-segment backpack. Written frames are handed to HostBoard.
+#ifndef HOST_ADAFRUIT_LEDBACKPACK_H
+#define HOST_ADAFRUIT_LEDBACKPACK_H
+
+#include <Arduino.h>
+
+namespace HostBoard {
+void displayFrame(const char text[4]);
+void displayBrightness(uint8_t level);
+}
+
+class Adafruit_AlphaNum4 {
+  public:
+    bool begin(uint8_t addr = 0x70) { (void)addr; clear(); return true; }
+    void setBrightness(uint8_t level) { HostBoard::displayBrightness(level); }
+    void blinkRate(uint8_t) {}
+    void clear() { memset(digits, ' ', sizeof(digits)); }
+    void writeDigitAscii(uint8_t n, uint8_t ascii, bool dot = false) { (void)dot; if (n < 4) digits[n] = ascii ? ascii : ' '; }
+    void writeDigitRaw(uint8_t n, uint16_t) { if (n < 4) digits[n] = '#'; }
+    void writeDisplay() { HostBoard::displayFrame(digits); }
+
+  private:
+    char digits[4];
+};
+
+#endif // HOST_ADAFRUIT_LEDBACKPACK_H
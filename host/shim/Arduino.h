@@ -0,0 +1,102 @@
+// Host stand-in for the Arduino core. Only what the DEALR firmware touches is provided.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+
+#define DEALR_HOST 1
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define LED_BUILTIN 13
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+#define NUM_DIGITAL_PINS 22
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+    size_t write(const uint8_t* buffer, size_t size) {
+        for (size_t i = 0; i < size; i++) write(buffer[i]);
+        return size;
+    }
+    size_t write(const char* str) { return write(reinterpret_cast<const uint8_t*>(str), strlen(str)); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(long n) { char b[16]; snprintf(b, sizeof(b), "%ld", n); return write(b); }
+    size_t print(unsigned long n) { char b[16]; snprintf(b, sizeof(b), "%lu", n); return write(b); }
+    size_t print(int n) { return print(static_cast<long>(n)); }
+    size_t print(unsigned int n) { return print(static_cast<unsigned long>(n)); }
+    size_t print(double n, int digits = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", digits, n); return write(b); }
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud);
+    void end() {}
+    size_t write(uint8_t b) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() {}
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+void setup();
+void loop();
+
+#endif // HOST_ARDUINO_H
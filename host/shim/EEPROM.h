@@ -0,0 +1,32 @@
+// Host stand-in for the Arduino EEPROM library, backed by HostBoard's 1 KB image.
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+namespace HostBoard {
+uint8_t* eepromImage();
+}
+
+#define E2END 0x3FF
+
+class EEPROMClass {
+  public:
+    uint8_t read(int addr) { return HostBoard::eepromImage()[addr & E2END]; }
+    void write(int addr, uint8_t value) { HostBoard::eepromImage()[addr & E2END] = value; }
+    void update(int addr, uint8_t value) { write(addr, value); }
+    uint16_t length() { return E2END + 1; }
+
+    template <typename T> T& get(int addr, T& value) {
+        memcpy(&value, HostBoard::eepromImage() + addr, sizeof(T));
+        return value;
+    }
+    template <typename T> const T& put(int addr, const T& value) {
+        memcpy(HostBoard::eepromImage() + addr, &value, sizeof(T));
+        return value;
+    }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
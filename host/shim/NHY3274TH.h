@@ -0,0 +1,24 @@
+// Host stand-in for the NHY3274TH colour sensor. Each read costs one integration period of virtual time.
+#ifndef HOST_NHY3274TH_H
+#define HOST_NHY3274TH_H
+
+#include <Arduino.h>
+
+namespace HostBoard {
+void sensorRead(uint8_t integrationTime, uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c);
+}
+
+class NHY3274TH {
+  public:
+    bool begin() { return true; }
+    void setIntegrationTime(uint8_t time) { integrationTime = time; }
+    void setGain(uint8_t value) { gain = value; }
+    void getRawData(uint16_t* r, uint16_t* g, uint16_t* b, uint16_t* c) { HostBoard::sensorRead(integrationTime, r, g, b, c); }
+    uint8_t getIntegrationTime() const { return integrationTime; } // Host only, for FirmwareProbe.
+
+  private:
+    uint8_t integrationTime = 0x1;
+    uint8_t gain = 0;
+};
+
+#endif // HOST_NHY3274TH_H
@@ -0,0 +1,23 @@
+// Host stand-in for the Servo library. The commanded angle is visible to the host model.
+#ifndef HOST_SERVO_H
+#define HOST_SERVO_H
+
+#include <Arduino.h>
+
+namespace HostBoard {
+void servoWrite(int angle);
+void servoAttached(bool attached);
+}
+
+class Servo {
+  public:
+    uint8_t attach(int pin) { attachedPin = pin; HostBoard::servoAttached(true); return 1; }
+    void detach() { attachedPin = -1; HostBoard::servoAttached(false); }
+    void write(int angle) { HostBoard::servoWrite(angle); }
+    bool attached() { return attachedPin >= 0; }
+
+  private:
+    int attachedPin = -1;
+};
+
+#endif // HOST_SERVO_H
@@ -0,0 +1,16 @@
+// Host stand-in for the Wire (I2C) library.
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+  public:
+    void begin() {}
+    void setClock(uint32_t hz) { clock = hz; }
+    uint32_t clock = 100000;
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
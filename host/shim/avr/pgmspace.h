@@ -0,0 +1,23 @@
+// Host stand-in for avr-libc's program-memory helpers. Flash and SRAM are the same address space here.
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_ptr(addr) (*reinterpret_cast<void* const*>(addr))
+
+#define memcpy_P memcpy
+#define strncpy_P strncpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+#endif // HOST_AVR_PGMSPACE_H
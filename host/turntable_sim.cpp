@@ -0,0 +1,489 @@
+// Plays Flip7 on the host against the Turntable model and predicts how long a round takes at the table.
+//
+//     dealr_turntable [--players 2-8] [--rounds n] [--think ms] [--seed n] [--jobs n] [--no-variants] [--capture file]
+//
+// For each player count, a simulated table registers, sets the game to 990 so nobody wins, and plays rounds with
+// fixed odds: hit or stand, bust, special cards (freeze and flip three), the occasional seven. Every prompt is
+// answered --think ms after it appears (score entry presses come quicker). The first round includes registration and
+// isn't counted. The report splits each round into time the table spent deciding and time DEALR spent, and DEALR's
+// share by what the motors were doing.
+//
+// Then each motion change in motionVariants[] is played with the same decisions and the same sensor noise, and the
+// time it saves per round is printed. Changes to the firmware's speed constants are tried by remapping the PWM the
+// model sees. Anything else, rebuild with the change and compare the two reports.
+//
+// --capture saves the Serial output of the baseline game with the fewest players. Built as
+// dealr_turntable_recording, with telemetry and session recording on, that's a capture dealr_replay can play back.
+//
+// Every game runs in its own process, since the firmware's globals can't be reset between games.
+
+#include "HostBoard.h"
+#include "FirmwareProbe.h"
+#include "Turntable.h"
+
+#include <Arduino.h>
+#include "Definitions.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Flip7's GameState values (games/Flip7.h), as getStateId() reports them.
+enum Flip7State {
+    STARTUP,
+    DEALSPECIAL,
+    ACTION,
+    PICK,
+    PICKSPECIAL,
+    PICKPLAYER,
+    ENTERSCORE,
+    REPORTSCORE,
+    SHOWSCORES,
+    GAMEOVER
+};
+
+// Odds the simulated table plays by.
+const double hitChance = 0.6;     // ACTION: hit rather than stand.
+const double bustChance = 0.2;    // PICK: the card busts the player.
+const double specialChance = 0.08; // DEALSPECIAL and PICK: the card is a freeze or flip three.
+const double sevenChance = 0.01;  // PICK: the player has seven cards.
+const int scoreTapsPerPlayer = 5; // ENTERSCORE: ones-digit taps for each player who didn't bust.
+const unsigned long tapGapMs = 350;
+const unsigned long menuGapMs = 1500;
+const unsigned long stuckAfterMs = 120000; // DEALR should be back at a prompt long before this, even after a win spin.
+const unsigned long gameLimitMs = 3600000; // One virtual hour for the whole game.
+
+struct Options {
+    int minPlayers = 2;
+    int maxPlayers = 8;
+    int rounds = 4;
+    unsigned long thinkMs = 2500;
+    uint32_t seed = 1;
+    int jobs = 0;
+    bool variants = true;
+    std::string capture;
+};
+
+struct Variant {
+    const char* name;
+    std::function<void(TurntableConfig&)> apply;
+};
+
+const Variant motionVariants[] = {
+    { "baseline", [](TurntableConfig&) {} },
+    { "steps at highSpeed", [](TurntableConfig& c) { c.pwmRemap[220] = 255; } },
+    { "fine adjust at 200", [](TurntableConfig& c) { c.pwmRemap[180] = 200; } },
+    { "yaw motor 25% faster", [](TurntableConfig& c) { c.fullSpeedDegPerSec *= 1.25; } },
+    { "half the table inertia", [](TurntableConfig& c) { c.spinUpMs /= 2; c.coastMs /= 2; } },
+    { "faster card feed", [](TurntableConfig& c) { c.feedMs = 120; c.cardGapMs = 150; } },
+};
+
+// What one game reports back to the parent. Plain data, so it can go through a pipe.
+struct GameResult {
+    bool ok = false;
+    char failure[48] = "";
+    int rounds = 0;
+    double roundMs = 0; // Totals over the counted rounds.
+    double tableMs = 0;
+    double highMs = 0;
+    double mediumMs = 0;
+    double lowMs = 0;
+    double coastMs = 0;
+    double throwMs = 0;
+    double degrees = 0;
+    int cards = 0;
+    double virtualMs = 0; // The whole game, registration included.
+};
+
+struct VirtualTimeLimit {};
+
+class Table {
+  public:
+    Table(const Options& options, int players, const Variant& variant)
+        : options(options), players(players), decisions(options.seed * 1000 + players) {
+        config.seed = options.seed * 1000 + players;
+        config.seatColors.clear();
+        for (int i = 1; i <= players; i++) {
+            config.seatColors.push_back(i);
+        }
+        variant.apply(config);
+    }
+
+    GameResult play() {
+        GameResult result;
+        HostBoard::reset();
+        Turntable turntable(config);
+        turntable.attach();
+        auto modelTick = HostBoard::onTick;
+        HostBoard::onTick = [modelTick](uint64_t nowUs) {
+            modelTick(nowUs);
+            if (nowUs > gameLimitMs * 1000ULL) {
+                throw VirtualTimeLimit();
+            }
+        };
+
+        try {
+            setup();
+            run(menuGapMs);
+            while (FirmwareProbe::gameState() != STARTUP || !FirmwareProbe::awaitingDecision()) {
+                if (HostBoard::nowMicros() > 60000000ULL) {
+                    snprintf(result.failure, sizeof(result.failure), "never reached the Flip7 start screen");
+                    return result;
+                }
+                if (FirmwareProbe::gameState() < 0) {
+                    press(BUTTON_PIN_1); // Through the intro texts and the game menu, Flip7 is the first game.
+                }
+                run(menuGapMs); // Flip7 goes straight to its start screen once picked.
+            }
+            press(BUTTON_PIN_3); // 200 wraps round to 990, so nobody wins during the run.
+            run(tapGapMs);
+            press(BUTTON_PIN_1);
+
+            int round = 0;
+            double roundStartMs = 0;
+            double tableAtStart = 0;
+            Turntable::Usage usageAtStart;
+            double lastPromptMs = nowMs();
+            int scorePhase = 0;
+            bool specialChosen = false;
+            bool playerShown = false;
+            while (round <= options.rounds) {
+                if (FirmwareProbe::errorShowing()) {
+                    snprintf(result.failure, sizeof(result.failure), "DEALR hit an error in round %d", round);
+                    return result;
+                }
+                if (!FirmwareProbe::awaitingDecision()) {
+                    if (nowMs() - lastPromptMs > stuckAfterMs) {
+                        snprintf(result.failure, sizeof(result.failure), "no prompt for %lu s in round %d", stuckAfterMs / 1000, round);
+                        return result;
+                    }
+                    run(10);
+                    continue;
+                }
+                lastPromptMs = nowMs();
+                int state = FirmwareProbe::gameState();
+                if (state == REPORTSCORE || state == GAMEOVER) {
+                    if (round > 0) { // The first round carries registration and isn't counted.
+                        const Turntable::Usage& u = turntable.usage();
+                        result.roundMs += nowMs() - roundStartMs;
+                        result.tableMs += tableMs - tableAtStart;
+                        result.highMs += u.highMs - usageAtStart.highMs;
+                        result.mediumMs += u.mediumMs - usageAtStart.mediumMs;
+                        result.lowMs += u.lowMs - usageAtStart.lowMs;
+                        result.coastMs += u.coastMs - usageAtStart.coastMs;
+                        result.throwMs += u.throwMs - usageAtStart.throwMs;
+                        result.degrees += u.degrees - usageAtStart.degrees;
+                        result.cards += u.cards - usageAtStart.cards;
+                        result.rounds++;
+                    }
+                    if (state == GAMEOVER) {
+                        break;
+                    }
+                    round++;
+                    if (round > options.rounds) {
+                        break;
+                    }
+                    roundStartMs = nowMs(); // The round starts when the table starts deciding to deal it.
+                    tableAtStart = tableMs;
+                    usageAtStart = turntable.usage();
+                    answer(BUTTON_PIN_1, options.thinkMs);
+                    continue;
+                }
+                if (state != ENTERSCORE) {
+                    scorePhase = 0;
+                }
+                if (state != PICKSPECIAL) {
+                    specialChosen = false;
+                }
+                if (state != PICKPLAYER) {
+                    playerShown = false;
+                }
+                double r = chance();
+                switch (state) {
+                    case DEALSPECIAL:
+                        answer(r < specialChance ? BUTTON_PIN_4 : BUTTON_PIN_1, options.thinkMs);
+                        break;
+                    case ACTION:
+                        answer(r < hitChance ? BUTTON_PIN_4 : BUTTON_PIN_1, options.thinkMs);
+                        break;
+                    case PICK:
+                        if (r < bustChance) {
+                            answer(BUTTON_PIN_4, options.thinkMs);
+                        } else if (r < bustChance + specialChance) {
+                            answer(BUTTON_PIN_3, options.thinkMs);
+                        } else if (r < bustChance + specialChance + sevenChance) {
+                            answer(BUTTON_PIN_2, options.thinkMs);
+                        } else {
+                            answer(BUTTON_PIN_1, options.thinkMs);
+                        }
+                        break;
+                    case PICKSPECIAL: // Freeze (yellow) or flip three (blue), then confirm.
+                        if (!specialChosen) {
+                            specialChosen = true;
+                            answer(r < 0.5 ? BUTTON_PIN_3 : BUTTON_PIN_2, options.thinkMs);
+                        } else {
+                            answer(BUTTON_PIN_1, tapGapMs);
+                        }
+                        break;
+                    case PICKPLAYER: // Show the next active player, then confirm.
+                        if (!playerShown) {
+                            playerShown = true;
+                            answer(BUTTON_PIN_2, options.thinkMs);
+                        } else {
+                            answer(BUTTON_PIN_1, tapGapMs);
+                        }
+                        break;
+                    case ENTERSCORE: // Green to start, then each player's taps and a green to move on.
+                        if (scorePhase == 0 || scorePhase % (scoreTapsPerPlayer + 1) == 0) {
+                            answer(BUTTON_PIN_1, scorePhase == 0 ? options.thinkMs : tapGapMs);
+                        } else {
+                            answer(BUTTON_PIN_2, tapGapMs);
+                        }
+                        scorePhase++;
+                        break;
+                    default:
+                        answer(BUTTON_PIN_1, options.thinkMs);
+                        break;
+                }
+            }
+        } catch (const VirtualTimeLimit&) {
+            snprintf(result.failure, sizeof(result.failure), "stuck for a virtual hour");
+            return result;
+        }
+        result.ok = result.rounds > 0;
+        if (!result.ok) {
+            snprintf(result.failure, sizeof(result.failure), "no rounds finished");
+        }
+        result.virtualMs = nowMs();
+        return result;
+    }
+
+  private:
+    static double nowMs() { return HostBoard::nowMicros() / 1000.0; }
+
+    static void run(unsigned long ms) {
+        uint64_t until = HostBoard::nowMicros() + static_cast<uint64_t>(ms) * 1000;
+        while (HostBoard::nowMicros() < until) {
+            loop();
+        }
+    }
+
+    static void press(int pin) {
+        HostBoard::setInputPin(pin, LOW);
+        run(100);
+        HostBoard::setInputPin(pin, HIGH);
+        run(50); // The release is what the firmware acts on, once it's debounced. Motion it starts runs in here.
+    }
+
+    // Waits as the table would, then presses. The wait is the table's time, not DEALR's.
+    void answer(int pin, unsigned long afterMs) {
+        run(afterMs);
+        tableMs += afterMs;
+        press(pin);
+    }
+
+    double chance() { return std::uniform_real_distribution<double>(0.0, 1.0)(decisions); }
+
+    const Options& options;
+    int players;
+    TurntableConfig config;
+    std::mt19937 decisions;
+    double tableMs = 0;
+};
+
+// Plays one game in a child process, so every game starts from freshly initialised firmware.
+struct Job {
+    int players;
+    int variant;
+    pid_t pid = -1;
+    int pipe = -1;
+    GameResult result;
+};
+
+void start(Job& job, const Options& options) {
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        snprintf(job.result.failure, sizeof(job.result.failure), "pipe failed");
+        return;
+    }
+    fflush(stdout);
+    job.pid = fork();
+    if (job.pid == 0) {
+        close(fds[0]);
+        Table table(options, job.players, motionVariants[job.variant]);
+        GameResult result = table.play();
+        if (!options.capture.empty() && job.variant == 0 && job.players == options.minPlayers) {
+            std::ofstream out(options.capture, std::ios::binary);
+            out << HostBoard::serialOutput();
+        }
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+    close(fds[1]);
+    job.pipe = fds[0];
+    if (job.pid < 0) {
+        snprintf(job.result.failure, sizeof(job.result.failure), "fork failed");
+        close(job.pipe);
+        job.pipe = -1;
+    }
+}
+
+void finish(Job& job) {
+    if (job.pipe < 0) {
+        return;
+    }
+    GameResult result;
+    if (read(job.pipe, &result, sizeof(result)) == sizeof(result)) {
+        job.result = result;
+    } else {
+        snprintf(job.result.failure, sizeof(job.result.failure), "simulation crashed");
+    }
+    close(job.pipe);
+    job.pipe = -1;
+    waitpid(job.pid, nullptr, 0);
+}
+
+double perRound(const GameResult& r, double total) { return r.rounds ? total / r.rounds / 1000.0 : 0; }
+
+void printBaseline(const std::vector<Job>& jobs) {
+    printf("Round time by players (seconds per round)\n\n");
+    printf("players   round   table   DEALR |   high    med    low  coast  throw |  laps  cards\n");
+    for (const Job& job : jobs) {
+        if (job.variant != 0) {
+            continue;
+        }
+        const GameResult& r = job.result;
+        if (!r.ok) {
+            printf("%7d   %s\n", job.players, r.failure);
+            continue;
+        }
+        printf("%7d  %6.1f  %6.1f  %6.1f | %6.1f %6.1f %6.1f %6.1f %6.1f | %5.1f %6.1f\n", job.players,
+            perRound(r, r.roundMs), perRound(r, r.tableMs), perRound(r, r.roundMs - r.tableMs), perRound(r, r.highMs),
+            perRound(r, r.mediumMs), perRound(r, r.lowMs), perRound(r, r.coastMs), perRound(r, r.throwMs),
+            r.degrees / 360.0 / r.rounds, static_cast<double>(r.cards) / r.rounds);
+    }
+    printf("\nhigh/med/low: yaw driven at highSpeed (seeks, spins), mediumSpeed (steps), lowSpeed (fine adjusts).\n");
+    printf("coast: table still turning after a stop. throw: flywheel running. The rest of DEALR's time is holds,\n");
+    printf("scrolling and sensor reads with the table still.\n");
+}
+
+void printVariants(const std::vector<Job>& jobs, const Options& options) {
+    const int variantCount = sizeof(motionVariants) / sizeof(motionVariants[0]);
+    printf("\nSeconds saved per round by each motion change\n\n%-24s", "change");
+    for (int players = options.minPlayers; players <= options.maxPlayers; players++) {
+        printf(" %6d", players);
+    }
+    printf("\n");
+    for (int v = 1; v < variantCount; v++) {
+        printf("%-24s", motionVariants[v].name);
+        for (int players = options.minPlayers; players <= options.maxPlayers; players++) {
+            const GameResult* base = nullptr;
+            const GameResult* changed = nullptr;
+            for (const Job& job : jobs) {
+                if (job.players == players && job.variant == 0) base = &job.result;
+                if (job.players == players && job.variant == v) changed = &job.result;
+            }
+            if (!base || !changed || !base->ok || !changed->ok) {
+                printf(" %6s", "fail");
+            } else {
+                printf(" %6.1f", perRound(*base, base->roundMs) - perRound(*changed, changed->roundMs));
+            }
+        }
+        printf("\n");
+    }
+    for (const Job& job : jobs) {
+        if (job.variant != 0 && !job.result.ok) {
+            printf("  %s, %d players: %s\n", motionVariants[job.variant].name, job.players, job.result.failure);
+        }
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--players" && hasValue) {
+            std::string range = argv[++i];
+            size_t dash = range.find('-');
+            options.minPlayers = atoi(range.c_str());
+            options.maxPlayers = dash == std::string::npos ? options.minPlayers : atoi(range.c_str() + dash + 1);
+        } else if (arg == "--rounds" && hasValue) {
+            options.rounds = atoi(argv[++i]);
+        } else if (arg == "--think" && hasValue) {
+            options.thinkMs = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--jobs" && hasValue) {
+            options.jobs = atoi(argv[++i]);
+        } else if (arg == "--no-variants") {
+            options.variants = false;
+        } else if (arg == "--capture" && hasValue) {
+            options.capture = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--players 2-8] [--rounds n] [--think ms] [--seed n] [--jobs n] [--no-variants] [--capture file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (options.minPlayers < 2 || options.maxPlayers > 8 || options.minPlayers > options.maxPlayers || options.rounds < 1) {
+        fprintf(stderr, "players must be within 2-8 and rounds at least 1\n");
+        return 1;
+    }
+    if (options.jobs <= 0) {
+        options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<Job> jobs;
+    const int variantCount = options.variants ? sizeof(motionVariants) / sizeof(motionVariants[0]) : 1;
+    for (int v = 0; v < variantCount; v++) {
+        for (int players = options.minPlayers; players <= options.maxPlayers; players++) {
+            Job job;
+            job.players = players;
+            job.variant = v;
+            jobs.push_back(job);
+        }
+    }
+
+    printf("Flip7 on the simulated turntable: %d counted rounds per game, %lu ms to answer each prompt, seed %u\n\n",
+        options.rounds, options.thinkMs, options.seed);
+    auto wallStart = std::chrono::steady_clock::now();
+    size_t next = 0;
+    size_t done = 0;
+    while (done < jobs.size()) {
+        size_t running = next - done;
+        if (next < jobs.size() && running < static_cast<size_t>(options.jobs)) {
+            start(jobs[next++], options);
+            continue;
+        }
+        finish(jobs[done++]); // Games finish in roughly the order they started, and each result is small.
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    printBaseline(jobs);
+    if (options.variants) {
+        printVariants(jobs, options);
+    }
+
+    double virtualSeconds = 0;
+    bool allOk = true;
+    for (const Job& job : jobs) {
+        virtualSeconds += job.result.virtualMs / 1000.0;
+        allOk = allOk && job.result.ok;
+    }
+    printf("\nSimulated %.0f minutes of play in %.1f s (%.0fx real time).\n", virtualSeconds / 60, wallSeconds,
+        wallSeconds > 0 ? virtualSeconds / wallSeconds : 0);
+    return allOk ? 0 : 2;
+}
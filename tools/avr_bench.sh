@@ -0,0 +1,27 @@
+#!/bin/sh
+# Builds the sketch with enableBenchmarks on and runs it in simavr, printing the BENCH lines (see Bench.h).
+#
+#     tools/avr_bench.sh [--libraries <dir>]
+#
+# Needs arduino-cli with the arduino:avr core and the sketch's libraries installed (or in the --libraries folder),
+# and simavr. The counts are CPU cycles at 16 MHz. To run the same suite on a real Nano, set enableBenchmarks to true
+# in Config.h, upload, and open the serial monitor at 115200 baud.
+
+set -e
+
+repo=$(cd "$(dirname "$0")/.." && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+libraries=""
+if [ "$1" = "--libraries" ] && [ -n "$2" ]; then
+    libraries="--libraries $2"
+fi
+
+cp -R "$repo/Flip7DealerMain" "$work/Flip7DealerMain"
+sed -i.bak 's/^#define enableBenchmarks false/#define enableBenchmarks true/' "$work/Flip7DealerMain/Config.h"
+
+arduino-cli compile --fqbn arduino:avr:nano $libraries --build-path "$work/build" "$work/Flip7DealerMain" >&2
+
+# simavr stops once the suite puts the CPU to sleep with interrupts off. The timeout covers a suite that never gets there.
+timeout 120 simavr -m atmega328p -f 16000000 "$work/build/Flip7DealerMain.ino.elf" 2>&1 | grep '^BENCH'
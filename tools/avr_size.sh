@@ -0,0 +1,52 @@
+#!/bin/sh
+# Builds the sketch for the Nano in three configurations and prints the flash and RAM each one uses.
+#
+#     tools/avr_size.sh [--libraries <dir>]
+#
+#     default       Config.h as it is.
+#     diagnostics   Every Serial diagnostic on: serial reports, telemetry, console, flight recorder, tracing, round
+#                   stats, profiler and session recording.
+#     dealer link   enableDealerLink alone, since it needs Serial to itself.
+#
+# Needs arduino-cli with the arduino:avr core and the sketch's libraries installed (or in the --libraries folder).
+# enableBenchmarks is left as Config.h has it; tools/avr_bench.sh builds that one. A configuration that doesn't
+# compile prints FAILED and makes the script exit 1 once every configuration has been tried.
+
+repo=$(cd "$(dirname "$0")/.." && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+libraries=""
+if [ "$1" = "--libraries" ] && [ -n "$2" ]; then
+    libraries="--libraries $2"
+fi
+
+status=0
+
+# build <name> <flag>... : copies the sketch, turns the flags on and compiles it.
+build() {
+    name=$1
+    shift
+    rm -rf "$work/Flip7DealerMain" "$work/build"
+    cp -R "$repo/Flip7DealerMain" "$work/Flip7DealerMain"
+    for flag in "$@"; do
+        sed -i.bak "s/^#define $flag false/#define $flag true/" "$work/Flip7DealerMain/Config.h"
+    done
+    if arduino-cli compile --fqbn arduino:avr:nano $libraries --build-path "$work/build" "$work/Flip7DealerMain" \
+        > "$work/log" 2>&1; then
+        flash=$(sed -n 's/^Sketch uses \([0-9]*\) bytes.*Maximum is \([0-9]*\) bytes.*/\1 of \2/p' "$work/log")
+        ram=$(sed -n 's/^Global variables use \([0-9]*\) bytes.*Maximum is \([0-9]*\) bytes.*/\1 of \2/p' "$work/log")
+        printf '%-12s  flash %s bytes, RAM %s bytes\n' "$name" "$flash" "$ram"
+    else
+        printf '%-12s  FAILED\n' "$name"
+        cat "$work/log" >&2
+        status=1
+    fi
+}
+
+build default
+build diagnostics enableSerialReports enableTelemetry enableConsole enableFlightRecorder enableTracing \
+    enableRoundStats enableProfiler enableSessionRecording
+build "dealer link" enableDealerLink
+
+exit $status
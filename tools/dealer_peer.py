@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Stands in for a follower DEALR, to try out a leader built with enableDealerLink set to true in Config.h.
+
+Connect a USB serial adapter to the leader's TX/RX pins (crossed over, grounds joined) and run:
+
+    python3 tools/dealer_peer.py /dev/ttyUSB0
+    python3 tools/dealer_peer.py /dev/ttyUSB0 --colors 5,6,7,8 --step 700 --card 900
+
+It answers the commands listed in DealerLink.h as a follower with the given tags would, taking --step ms for each
+tag it turns past and --card ms for each card, and prints every command and its reply. When the game is over,
+Ctrl-C prints how long the leader waited for remote deals. The adapter shouldn't reset the
+leader when the port opens, so start a Flip7 game on the leader after this is running. Needs pyserial.
+"""
+
+import argparse
+import statistics
+import time
+
+import serial
+
+
+class Follower:
+    def __init__(self, colors, step_ms, card_ms):
+        self.colors = colors
+        self.step_ms = step_ms
+        self.card_ms = card_ms
+        self.at = 0  # index into colors of the tag under the sensor
+        self.busy_until = 0.0  # when the seeks still queued up would have finished
+        self.deal_waits = []
+
+    def turn_to(self, color):
+        """Returns the ms a clockwise seek to the color takes, or None if it isn't one of this table's tags."""
+        if color not in self.colors:
+            return None
+        target = self.colors.index(color)
+        steps = (target - self.at) % len(self.colors)
+        self.at = target
+        return steps * self.step_ms
+
+    def answer(self, line):
+        """Returns the reply to a command. It's due at busy_until: commands run one after another, as the follower's
+        task does, so a deal waits for any seek before it."""
+        now = time.monotonic()
+        start = max(now, self.busy_until)
+        words = line.split()
+        if words == ["h"]:
+            self.busy_until = start
+            return "h"
+        if words == ["r"]:
+            self.busy_until = start + len(self.colors) * self.step_ms / 1000.0
+            self.at = 0
+            return "r %d %s" % (len(self.colors), " ".join(str(c) for c in self.colors))
+        if len(words) == 2 and words[0] == "s":
+            ms = self.turn_to(int(words[1]))
+            if ms is None:
+                self.busy_until = start
+                return "? s %s" % words[1]
+            self.busy_until = start + ms / 1000.0
+            return "s %s %d" % (words[1], ms)
+        if len(words) == 3 and words[0] == "d":
+            ms = self.turn_to(int(words[1]))
+            if ms is None:
+                self.busy_until = start
+                return "? d %s" % words[1]
+            ms += int(words[2]) * self.card_ms
+            self.busy_until = start + ms / 1000.0
+            self.deal_waits.append((self.busy_until - now) * 1000.0)
+            return "d %s %d" % (words[2], ms)
+        self.busy_until = start
+        return "? " + line
+
+
+def run(port, follower):
+    link = serial.Serial(port, 115200, timeout=0.02)
+    pending = []  # (due time, reply) for commands the follower would still be working on
+    buffer = b""
+    while True:
+        buffer += link.read(64)
+        while b"\n" in buffer:
+            raw, buffer = buffer.split(b"\n", 1)
+            line = raw.decode("ascii", "replace").strip()
+            if not line:
+                continue
+            reply = follower.answer(line)
+            pending.append((follower.busy_until, reply))
+            print("%-12s -> %s" % (line, reply))
+        now = time.monotonic()
+        for due, reply in [p for p in pending if p[0] <= now]:
+            link.write((reply + "\n").encode("ascii"))
+        pending = [p for p in pending if p[0] > now]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port")
+    parser.add_argument("--colors", default="5,6,7,8", help="the follower's tags clockwise from where it starts, as ColorNames.h numbers")
+    parser.add_argument("--step", type=int, default=600, help="ms to turn from one tag to the next")
+    parser.add_argument("--card", type=int, default=800, help="ms to throw one card")
+    args = parser.parse_args()
+
+    follower = Follower([int(c) for c in args.colors.split(",")], args.step, args.card)
+    try:
+        run(args.port, follower)
+    except KeyboardInterrupt:
+        pass
+    waits = follower.deal_waits
+    if waits:
+        print()
+        print(
+            "%d remote deals: the leader waited mean %.0f ms, max %.0f ms"
+            % (len(waits), statistics.mean(waits), max(waits))
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Unattended soak run against DEALR's Serial console (build with enableConsole set to true in Config.h).
+
+Repeats seek-then-deal cycles and reports throughput and failure rates:
+
+    python3 tools/dealr_soak.py /dev/ttyUSB0 --cycles 500
+    python3 tools/dealr_soak.py /dev/ttyUSB0 --cycles 200 --seek 2 --deal 0   # rotation only
+
+Put player tags on the table and cards in the tray first. DEALR should sit in a menu (deal state IDLE), since
+the console refuses seeks and deals while a deal state owns the motors. Telemetry frames on the same port are
+skipped, so telemetry can stay enabled during the run. Needs pyserial.
+"""
+
+import argparse
+import statistics
+import sys
+import time
+
+import serial
+
+from telemetry_decode import Decoder
+
+
+class Console:
+    def __init__(self, port, baud):
+        self.port = serial.Serial(port, baud, timeout=0.1)
+        self.lines = []
+        self.decoder = Decoder(self)
+        time.sleep(2.0)  # Opening the port resets the Nano. Let it boot.
+        self.port.reset_input_buffer()
+
+    def write(self, text):
+        # Decoder output: text lines come through as "# ...", decoded telemetry frames as everything else.
+        for line in text.splitlines():
+            if line.startswith("# "):
+                self.lines.append(line[2:].strip())
+
+    def command(self, text, timeout):
+        """Sends one command and waits for the line that answers it. Returns None on timeout."""
+        self.lines.clear()
+        self.port.write((text + "\n").encode("ascii"))
+        letter = text[0]
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            self.decoder.feed(self.port.read(256))
+            self.decoder.flush_text()
+            for line in self.lines:
+                if line.startswith(letter + " ") or line.startswith("?"):
+                    return line
+            self.lines.clear()
+        return None
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def summarize(name, times, failures, attempts):
+    if attempts == 0:
+        return
+    print(
+        "%-5s %4d ok %3d failed (%.1f%%)  mean %5.0f ms  p95 %5.0f ms  max %5.0f ms"
+        % (
+            name,
+            len(times),
+            failures,
+            100.0 * failures / attempts,
+            statistics.mean(times) if times else 0,
+            percentile(times, 0.95),
+            max(times) if times else 0,
+        )
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--cycles", type=int, default=100)
+    parser.add_argument("--seek", type=int, default=1, help="tags to seek per cycle (0 to skip)")
+    parser.add_argument("--deal", type=int, default=1, help="cards to deal per cycle (0 to skip)")
+    parser.add_argument("--timeout", type=float, default=30.0, help="seconds before a command counts as hung")
+    args = parser.parse_args()
+
+    console = Console(args.port, args.baud)
+    state = console.command("q", 2.0)
+    if state is None:
+        sys.exit("No reply from the console. Is enableConsole set to true?")
+    print("start:", state)
+    console.command("c r", 2.0)
+
+    seek_times, deal_times = [], []
+    seek_failures = deal_failures = 0
+    started = time.monotonic()
+    for cycle in range(1, args.cycles + 1):
+        if args.seek:
+            reply = console.command("k %d" % args.seek, args.timeout)
+            if reply and reply.startswith("k "):
+                seek_times.append(int(reply.split()[2]))
+            else:
+                seek_failures += 1
+                print("cycle %d: seek failed: %s" % (cycle, reply or "timeout"))
+        if args.deal:
+            reply = console.command("d %d" % args.deal, args.timeout)
+            if reply and reply.startswith("d ") and int(reply.split()[1]) == args.deal:
+                deal_times.append(int(reply.split()[2]))
+            else:
+                deal_failures += 1
+                print("cycle %d: deal failed: %s" % (cycle, reply or "timeout"))
+        if cycle % 10 == 0:
+            elapsed = time.monotonic() - started
+            print("%d/%d cycles, %.0f cycles/hour" % (cycle, args.cycles, cycle * 3600.0 / elapsed))
+
+    elapsed = time.monotonic() - started
+    print()
+    print("%d cycles in %.0f s (%.0f cycles/hour)" % (args.cycles, elapsed, args.cycles * 3600.0 / elapsed))
+    summarize("seek", seek_times, seek_failures, seek_failures + len(seek_times))
+    summarize("deal", deal_times, deal_failures, deal_failures + len(deal_times))
+    print("counters:", console.command("c", 2.0))
+
+
+if __name__ == "__main__":
+    main()
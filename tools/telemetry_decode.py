@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Decode DEALR's binary telemetry stream (see Flip7DealerMain/Telemetry.h) into readable lines.
+
+Reads from a serial port or a captured file:
+
+    python3 tools/telemetry_decode.py /dev/ttyUSB0
+    python3 tools/telemetry_decode.py capture.bin
+
+Frame layout: [0xA5][id][len][millis u32 LE][payload][checksum], where the checksum is the 8-bit sum of every
+byte after 0xA5. Event names and payload formats come from the schema frames DEALR sends at boot. If the capture
+started late, the schema is read from Telemetry.h instead. Enum fields (deal states, display states, error
+codes, trace spans) are shown by name using Enums.h and Tracing.h. Bytes outside frames (text reports) are passed through unchanged.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+SCHEMA_ID = 0
+SOURCE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Flip7DealerMain")
+
+# Which enum from Enums.h each field of an event holds, if any.
+FIELD_ENUMS = {
+    "DEAL_STATE": ("dealState", "dealState"),
+    "DISPLAY": ("displayState", "displayState"),
+    "ERROR": ("errorCode", "dealState"),
+    "SPAN_BEGIN": ("TraceSpan",),
+    "SPAN_END": ("TraceSpan",),
+}
+
+ENUM_SOURCES = ("Enums.h", "Tracing.h")
+
+
+def read_source(name):
+    try:
+        with open(os.path.join(SOURCE_DIR, name)) as f:
+            return f.read()
+    except OSError:
+        return ""
+
+
+def load_enums():
+    """Returns {enum name: [member names in order]} for the plain sequential enums in ENUM_SOURCES."""
+    enums = {}
+    source = "".join(read_source(name) for name in ENUM_SOURCES)
+    for name, body in re.findall(r"enum\s+(\w+)\s*(?::\s*\w+\s*)?\{(.*?)\}", source, re.S):
+        body = re.sub(r"//[^\n]*", "", body)
+        members = [m.strip() for m in body.split(",") if m.strip()]
+        if all(re.fullmatch(r"\w+", m) for m in members):
+            enums[name] = members
+    return enums
+
+
+def load_schema():
+    """Falls back to the event table in Telemetry.h: {id: (name, format)}."""
+    schema = {}
+    events = re.findall(r'X\(\s*EVT_\w+\s*,\s*"(\w+)"\s*,\s*"(\w*)"\s*\)', read_source("Telemetry.h"))
+    for index, (name, fmt) in enumerate(events, start=1):
+        schema[index] = (name, fmt)
+    return schema
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.schema = load_schema()
+        self.enums = load_enums()
+        self.buffer = bytearray()
+        self.text = bytearray()
+        self.bad_frames = 0
+
+    def feed(self, data):
+        self.buffer += data
+        while self.buffer:
+            if self.buffer[0] != SYNC:
+                self.passthrough(self.buffer.pop(0))
+                continue
+            if len(self.buffer) < 3:
+                return
+            length = self.buffer[2]
+            end = 1 + 2 + 4 + length + 1
+            if len(self.buffer) < end:
+                return
+            frame = self.buffer[:end]
+            if sum(frame[1:-1]) & 0xFF != frame[-1]:
+                # Not a real frame, or a corrupted one. Skip the sync byte and look for the next.
+                self.bad_frames += 1
+                self.buffer.pop(0)
+                continue
+            del self.buffer[:end]
+            self.flush_text()
+            event_id = frame[1]
+            millis = struct.unpack_from("<I", frame, 3)[0]
+            self.handle(event_id, millis, bytes(frame[7:-1]))
+
+    def passthrough(self, byte):
+        if byte == ord("\n"):
+            self.flush_text()
+        elif byte != ord("\r"):
+            self.text.append(byte)
+
+    def flush_text(self):
+        if self.text:
+            self.out.write("# " + self.text.decode("ascii", "replace") + "\n")
+            self.text.clear()
+
+    def handle(self, event_id, millis, payload):
+        if event_id == SCHEMA_ID:
+            described_id = payload[0]
+            name, _, fmt = payload[1:].partition(b"\0")
+            self.schema[described_id] = (name.decode("ascii", "replace"), fmt.decode("ascii", "replace"))
+            return
+        name, fmt = self.schema.get(event_id, ("EVT%d" % event_id, None))
+        if fmt is None or struct.calcsize("<" + fmt) != len(payload):
+            values = None
+        else:
+            values = struct.unpack("<" + fmt, payload)
+        self.event(name, millis, values, payload)
+
+    def event(self, name, millis, values, payload):
+        """Called for every decoded event. values is None when the payload doesn't match the schema.
+        Override this to do something other than print a line per event."""
+        if values is None:
+            fields = [payload.hex()]
+        else:
+            fields = [self.label(name, i, v) for i, v in enumerate(values)]
+        self.out.write("%10.3f %-10s %s\n" % (millis / 1000.0, name, " ".join(str(f) for f in fields)))
+
+    def label(self, event, index, value):
+        enum_names = FIELD_ENUMS.get(event, ())
+        if index < len(enum_names):
+            members = self.enums.get(enum_names[index], [])
+            if value < len(members):
+                return members[value]
+        return value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="serial port or captured file ('-' for stdin)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    decoder = Decoder(sys.stdout)
+    if args.source == "-":
+        stream = sys.stdin.buffer
+    elif os.path.isfile(args.source):
+        stream = open(args.source, "rb")
+    else:
+        import serial  # pyserial, only needed for live ports
+
+        stream = serial.Serial(args.source, args.baud)
+
+    try:
+        while True:
+            data = stream.read(1 if hasattr(stream, "in_waiting") else 4096)
+            if not data:
+                break
+            decoder.feed(data)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    decoder.flush_text()
+    if decoder.bad_frames:
+        sys.stderr.write("%d frames failed their checksum\n" % decoder.bad_frames)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Convert a DEALR telemetry capture into a Chrome trace timeline (build with enableTelemetry and enableTracing).
+
+    python3 tools/trace_to_chrome.py capture.bin -o dealr_trace.json
+    python3 tools/trace_to_chrome.py /dev/ttyUSB0 -o dealr_trace.json      # live, stop with Ctrl-C
+
+Open the result in chrome://tracing or https://ui.perfetto.dev. It has four tracks:
+
+    deal state   One slice per dealState, from the DEAL_STATE events.
+    game state   One slice per state of the current game, from the GAME_STATE events.
+    spans        SPAN_BEGIN/SPAN_END pairs from Tracing.h (seeks, steps, fine adjusts, throws, ...), nested.
+    events       Buttons, confirmed tags, cards and errors as instant markers.
+
+If DEALR reboots during the capture, millis() starts again from 0. Later events are shifted so the timeline keeps
+going forward, and a BOOT marker shows where it happened. Anything still open when the capture ends is closed at
+the last event.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+from telemetry_decode import Decoder, read_source
+
+TRACKS = ("deal state", "game state", "spans", "events")
+DEAL_TRACK, GAME_TRACK, SPAN_TRACK, EVENT_TRACK = range(1, len(TRACKS) + 1)
+INSTANT_EVENTS = ("BOOT", "BUTTON", "TAG", "CARD", "ERROR")
+
+
+def load_game_states(spec):
+    """Reads "games/Flip7.h:GameState" into a list of state names, so GAME_STATE ids can be shown by name."""
+    path, _, enum_name = spec.partition(":")
+    match = re.search(r"enum\s+%s\s*\{(.*?)\}" % re.escape(enum_name), read_source(path), re.S)
+    if not match:
+        return []
+    body = re.sub(r"//[^\n]*", "", match.group(1))
+    return [m.strip() for m in body.split(",") if m.strip()]
+
+
+class ChromeTrace(Decoder):
+    def __init__(self, game_states):
+        super().__init__(sys.stderr)
+        self.game_states = game_states
+        self.trace = []
+        self.open_slices = {}  # track -> (name, start us, args) for the deal and game state tracks
+        self.span_stack = []   # (span name, detail, start us), innermost last
+        self.offset_us = 0     # Added to every timestamp after DEALR reboots.
+        self.last_us = 0
+        self.unmatched_ends = 0
+        for tid, name in enumerate(TRACKS, start=1):
+            self.trace.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": name}})
+            self.trace.append({"name": "thread_sort_index", "ph": "M", "pid": 1, "tid": tid, "args": {"sort_index": tid}})
+
+    def event(self, name, millis, values, payload):
+        us = millis * 1000 + self.offset_us
+        if us < self.last_us:
+            # millis() went backwards: DEALR rebooted. Close everything from the last run where it stopped.
+            self.close_all(self.last_us)
+            self.offset_us = self.last_us
+            us = millis * 1000 + self.offset_us
+        self.last_us = us
+        if values is None:
+            return
+
+        if name == "DEAL_STATE":
+            self.switch_slice(DEAL_TRACK, self.label(name, 1, values[1]), us)
+        elif name == "GAME_STATE":
+            after = values[1]
+            state = self.game_states[after] if after < len(self.game_states) else "state %d" % after
+            self.switch_slice(GAME_TRACK, state, us)
+        elif name == "SPAN_BEGIN":
+            self.span_stack.append((self.label(name, 0, values[0]), values[1], us))
+        elif name == "SPAN_END":
+            self.end_span(self.label(name, 0, values[0]), us)
+        elif name in INSTANT_EVENTS:
+            args = {"field%d" % i: self.label(name, i, v) for i, v in enumerate(values)}
+            self.trace.append({"name": name, "ph": "i", "s": "t", "pid": 1, "tid": EVENT_TRACK, "ts": us, "args": args})
+
+    def switch_slice(self, track, name, us):
+        self.close_slice(track, us)
+        self.open_slices[track] = (name, us)
+
+    def close_slice(self, track, us):
+        if track in self.open_slices:
+            name, start = self.open_slices.pop(track)
+            self.complete(track, name, start, us, {})
+
+    def end_span(self, name, us):
+        # Spans are scoped, so the END normally matches the innermost open span. If frames were lost, close
+        # anything opened inside the matching span along with it.
+        for index in range(len(self.span_stack) - 1, -1, -1):
+            if self.span_stack[index][0] == name:
+                while len(self.span_stack) > index:
+                    span, detail, start = self.span_stack.pop()
+                    self.complete(SPAN_TRACK, span, start, us, {"detail": detail})
+                return
+        self.unmatched_ends += 1
+
+    def close_all(self, us):
+        for track in list(self.open_slices):
+            self.close_slice(track, us)
+        while self.span_stack:
+            span, detail, start = self.span_stack.pop()
+            self.complete(SPAN_TRACK, span, start, us, {"detail": detail})
+
+    def complete(self, track, name, start, end, args):
+        self.trace.append({"name": name, "ph": "X", "pid": 1, "tid": track, "ts": start, "dur": end - start, "args": args})
+
+    def result(self):
+        self.close_all(self.last_us)
+        return {"traceEvents": self.trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="serial port or captured file ('-' for stdin)")
+    parser.add_argument("-o", "--output", default="-", help="where to write the JSON (default stdout)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--game-states", default=os.path.join("games", "Flip7.h") + ":GameState",
+                        help="header and enum naming the current game's states (default games/Flip7.h:GameState)")
+    args = parser.parse_args()
+
+    converter = ChromeTrace(load_game_states(args.game_states))
+    if args.source == "-":
+        stream = sys.stdin.buffer
+    elif os.path.isfile(args.source):
+        stream = open(args.source, "rb")
+    else:
+        import serial  # pyserial, only needed for live ports
+
+        stream = serial.Serial(args.source, args.baud)
+
+    try:
+        while True:
+            data = stream.read(1 if hasattr(stream, "in_waiting") else 4096)
+            if not data:
+                break
+            converter.feed(data)
+    except KeyboardInterrupt:
+        pass
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    json.dump(converter.result(), out, separators=(",", ":"))
+    out.write("\n")
+    if converter.bad_frames:
+        sys.stderr.write("%d frames failed their checksum\n" % converter.bad_frames)
+    if converter.unmatched_ends:
+        sys.stderr.write("%d SPAN_END events had no matching SPAN_BEGIN\n" % converter.unmatched_ends)
+
+
+if __name__ == "__main__":
+    main()